@@ -1,8 +1,20 @@
 #include <iostream>
 #include <string>
 #include <math.h>
+#include <algorithm>
+#include <numeric>
 #include <thread>
 #include <mutex>
+#include <chrono>
+#include <atomic>
+#include <memory>
+#include <exception>
+#include <climits>
+#include <ctime>
+#include <random>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
 
 #include <SplitRun.h>
 #include "AlgorithmComplexityAndReentrancyAnalysis.h"
@@ -25,10 +37,18 @@ string AlgorithmComplexityAndReentrancyAnalysis::
             return "O(1)"s;
         case EAlgorithmComplexity::Ologn:
             return "O(log(n))"s;
+        case EAlgorithmComplexity::Olog2n:
+            return "O(log^2(n))"s;
+        case EAlgorithmComplexity::Osqrtn:
+            return "O(sqrt(n))"s;
         case EAlgorithmComplexity::BetweenOLogNAndOn:
             return "Worse than O(log(n)) but better than O(n)"s;
         case EAlgorithmComplexity::On:
             return "O(n)"s;
+        case EAlgorithmComplexity::Onlogn:
+            return "O(n*log(n))"s;
+        case EAlgorithmComplexity::On2:
+            return "O(n^2)"s;
         case EAlgorithmComplexity::WorseThanOn:
             return "Worse than O(n)"s;
         default:
@@ -37,13 +57,40 @@ string AlgorithmComplexityAndReentrancyAnalysis::
 }
 
 
+const char* AlgorithmComplexityAndReentrancyAnalysis::
+        EAlgorithmComplexityToIdentifier(EAlgorithmComplexity complexity) {
+    switch (complexity) {
+        case EAlgorithmComplexity::BetterThanO1:      return "BetterThanO1";
+        case EAlgorithmComplexity::O1:                return "O1";
+        case EAlgorithmComplexity::Ologn:             return "Ologn";
+        case EAlgorithmComplexity::Olog2n:            return "Olog2n";
+        case EAlgorithmComplexity::Osqrtn:            return "Osqrtn";
+        case EAlgorithmComplexity::BetweenOLogNAndOn: return "BetweenOLogNAndOn";
+        case EAlgorithmComplexity::On:                return "On";
+        case EAlgorithmComplexity::Onlogn:            return "Onlogn";
+        case EAlgorithmComplexity::On2:               return "On2";
+        case EAlgorithmComplexity::WorseThanOn:       return "WorseThanOn";
+        default:                                      return "Unknown";
+    }
+}
+
+
 AlgorithmComplexityAndReentrancyAnalysis::
         AlgorithmComplexityAndReentrancyAnalysis(string testName, int numberOfInsertElements, int numberOfSelectElements, int numberOfUpdateElements)
             : testName                (testName)
             , inserts                 (numberOfInsertElements)
 			, selects                 (numberOfSelectElements)
             , updates                 (numberOfUpdateElements)
-            , deletes                 (numberOfInsertElements) {}
+            , deletes                 (numberOfInsertElements)
+            , measureLatencies        (false)
+            , measurePerformanceCounters(false)
+            , trackAllocations        (false)
+            , recordTimelines         (false)
+            , warmUpMaximumCoefficientOfVariation(0.05)
+            , warmUpWindowBatches     (8)
+            , warmUpTimeBudgetS       (5.0)
+            , historyEventsPerThread  (0)
+            , lastWarmUp              {} {}
 
 
 AlgorithmComplexityAndReentrancyAnalysis::
@@ -51,6 +98,142 @@ AlgorithmComplexityAndReentrancyAnalysis::
             : AlgorithmComplexityAndReentrancyAnalysis(testName, elements, elements, elements) {}
 
 
+#define OUTPUT_MESSAGE(s) outputMessages.append(s); if (verbose) cerr << s << flush
+string AlgorithmComplexityAndReentrancyAnalysis::
+        autoSizeElements(double targetPassS, double maximumPassS, unsigned int maximumElements, bool verbose) {
+
+    constexpr unsigned int probeElements   = 1024;
+    const double           targetPassNS    = targetPassS  * 1e9;
+    const double           maximumProbeNS  = maximumPassS * 1e9;
+    string                 outputMessages  = "";
+
+    if ( (targetPassS <= 0.0) || (maximumPassS < targetPassS) || (maximumElements < 2) ) {
+        THROW_EXCEPTION(std::invalid_argument, "Cannot auto size for passes of " + to_string(targetPassS) + "s, limited to " + to_string(maximumPassS) +
+                                               "s and " + to_string(maximumElements) + " elements");
+    }
+
+    // times 'rangeAlgorithm' on [begin, end[, in nanoseconds
+    auto timeRange = [this](auto rangeAlgorithm, unsigned int begin, unsigned int end) {
+        unsigned long long start  = clock.start();
+        rangeAlgorithm(begin, end);
+        unsigned long long finish = clock.stop();
+        return clock.elapsedNS(start, finish);
+    };
+
+    OUTPUT_MESSAGE(testName + " Auto Sizing (target pass: " + to_string(targetPassS) + "s): ");
+    resetTablesOnPlacementCpus(EResetOccasion::FULL_RESET);
+
+    // INSERTS: doubling chunks, so the elapsed time covers inserting 'n' elements on an initially empty data set -- as the first pass does
+    unsigned int n        = 0;
+    double       insertNS = 0.0;
+    while (n < maximumElements) {
+        unsigned int chunk   = std::min(std::max(n, probeElements), maximumElements - n);
+        double       chunkNS = timeRange([this](unsigned int b, unsigned int e) { insertRange(b, e); }, n, n+chunk);
+        n        += chunk;
+        insertNS += chunkNS;
+        OUTPUT_MESSAGE("n=" + to_string(n) + " ");
+        if ( (insertNS >= targetPassNS) || (chunkNS >= maximumProbeNS) ) {
+            break;
+        }
+    }
+    // each pass inserts half of the elements
+    double       perPassInserts = insertNS > 0.0 ? ((double)n) * targetPassNS / insertNS : (double)maximumElements;
+    unsigned int newInserts     = (unsigned int)std::max(2.0, std::min(2.0 * perPassInserts, (double)maximumElements));
+
+    // SELECTS & UPDATES: timed on the inserted elements -- they may not operate on more elements than the ones inserted
+    double selectNS = timeRange([this](unsigned int b, unsigned int e) { selectRange(b, e); }, 0, n);
+    double updateNS = timeRange([this](unsigned int b, unsigned int e) { updateRange(b, e); }, 0, n);
+    auto perPassOperations = [&](double probeNS) {
+        double operations = probeNS > 0.0 ? ((double)n) * targetPassNS / probeNS : (double)newInserts;
+        return (unsigned int)std::max(2.0, std::min(2.0 * operations, (double)newInserts));
+    };
+
+    inserts = deletes = newInserts;
+    selects = perPassOperations(selectNS);
+    updates = perPassOperations(updateNS);
+
+    resetTablesOnPlacementCpus(EResetOccasion::FINAL_RESET);
+    OUTPUT_MESSAGE("Done: probed " + to_string(n) + " inserts in " + to_string(insertNS/1e6) + "ms, selects in " + to_string(selectNS/1e6) +
+                   "ms & updates in " + to_string(updateNS/1e6) + "ms --> " + to_string(inserts) + " inserts & deletes, " +
+                   to_string(selects) + " selects, " + to_string(updates) + " updates.\n");
+    return outputMessages;
+}
+#undef OUTPUT_MESSAGE
+
+
+void AlgorithmComplexityAndReentrancyAnalysis::enableLatencyHistograms(bool enable) {
+    measureLatencies = enable;
+}
+
+
+void AlgorithmComplexityAndReentrancyAnalysis::enablePerformanceCounters(bool enable) {
+    measurePerformanceCounters = enable;
+}
+
+
+tuple<vector<PerformanceCounters::Values>, vector<PerformanceCounters::Values>, vector<PerformanceCounters::Values>, vector<PerformanceCounters::Values>> AlgorithmComplexityAndReentrancyAnalysis::
+        getPerformanceCounters() {
+    return {insertPerformanceCounters, selectPerformanceCounters, updatePerformanceCounters, deletePerformanceCounters};
+}
+
+
+void AlgorithmComplexityAndReentrancyAnalysis::enableAllocationTracking(bool enable) {
+    trackAllocations = enable;
+}
+
+
+tuple<vector<AllocationTracker::Values>, vector<long long>> AlgorithmComplexityAndReentrancyAnalysis::getInsertAllocations() {
+    return {insertAllocations, insertResidentSetSizeDeltas};
+}
+
+
+void AlgorithmComplexityAndReentrancyAnalysis::enableOperationTimelines(bool enable) {
+    recordTimelines = enable;
+}
+
+
+void AlgorithmComplexityAndReentrancyAnalysis::enableHistoryRecording(unsigned int eventsPerThread) {
+    historyEventsPerThread = eventsPerThread;
+    lastHistory.reset();
+}
+
+
+void AlgorithmComplexityAndReentrancyAnalysis::setClock(const PrecisionClock& clock) {
+    this->clock = clock;
+}
+
+
+void AlgorithmComplexityAndReentrancyAnalysis::setWarmUp(double maximumCoefficientOfVariation, unsigned int windowBatches, double timeBudgetS) {
+    if ( (maximumCoefficientOfVariation <= 0.0) || (windowBatches < 2) || (timeBudgetS <= 0.0) ) {
+        THROW_EXCEPTION(std::invalid_argument, "A warm up needs a positive coefficient of variation, a window of at least 2 batches and a positive time budget");
+    }
+    warmUpMaximumCoefficientOfVariation = maximumCoefficientOfVariation;
+    warmUpWindowBatches                 = windowBatches;
+    warmUpTimeBudgetS                   = timeBudgetS;
+}
+
+
+void AlgorithmComplexityAndReentrancyAnalysis::setThreadPlacement(const ThreadPlacement& placement) {
+    threadPlacement = placement;
+}
+
+
+void AlgorithmComplexityAndReentrancyAnalysis::setKeyDistribution(const KeyDistribution& distribution) {
+    keyDistribution = distribution;
+}
+
+
+void AlgorithmComplexityAndReentrancyAnalysis::resetTablesOnPlacementCpus(EResetOccasion occasion) {
+    threadPlacement.runOnPlacementCpus([this, occasion]() { resetTables(occasion); });
+}
+
+
+tuple<vector<LatencyHistogram>, vector<LatencyHistogram>, vector<LatencyHistogram>, vector<LatencyHistogram>> AlgorithmComplexityAndReentrancyAnalysis::
+        getLatencyHistograms() {
+    return {insertLatencyHistograms, selectLatencyHistograms, updateLatencyHistograms, deleteLatencyHistograms};
+}
+
+
 // complexity analysis & reentrancy algorithms under test
 /////////////////////////////////////////////////////////
 
@@ -75,84 +258,355 @@ void AlgorithmComplexityAndReentrancyAnalysis::deleteAlgorithm(unsigned int i) {
 }
 
 
+void AlgorithmComplexityAndReentrancyAnalysis::insertRange(unsigned int begin, unsigned int end) {
+    for (unsigned int i=begin; i<end; i++) {
+        insertAlgorithm(i);
+    }
+}
+
+
+void AlgorithmComplexityAndReentrancyAnalysis::selectRange(unsigned int begin, unsigned int end) {
+    for (unsigned int i=begin; i<end; i++) {
+        selectAlgorithm(i);
+    }
+}
+
+
+void AlgorithmComplexityAndReentrancyAnalysis::updateRange(unsigned int begin, unsigned int end) {
+    for (unsigned int i=begin; i<end; i++) {
+        updateAlgorithm(i);
+    }
+}
+
+
+void AlgorithmComplexityAndReentrancyAnalysis::deleteRange(unsigned int begin, unsigned int end) {
+    for (unsigned int i=begin; i<end; i++) {
+        deleteAlgorithm(i);
+    }
+}
+
+
 class AlgorithmAnalysisSplitRun: public SplitRun {
 public:
+    /** How the operation's elements are mapped through the key distribution: not at all, to a permutation of the pass' elements
+      * -- each touched once -- or to a sample of the elements already present */
+    enum class EKeyMapping {NONE, PERMUTATION, SAMPLE};
+
     const int                                 threadNumber;
     const int                                 perThreadNumberOfOperations;
     AlgorithmComplexityAndReentrancyAnalysis* algorithms;
-    const int                                 pass;
-    const int                                 perPassNumberOfElements;
-
-    AlgorithmAnalysisSplitRun(int threadNumber, int perThreadNumberOfOperations, AlgorithmComplexityAndReentrancyAnalysis* algorithms, int pass, int perPassNumberOfElements)
+    const unsigned int                        firstElement;     // the first element of the pass -- each thread operates on 'perThreadNumberOfOperations' elements after it
+    LatencyHistogram*                         latencyHistogram; // this thread's histogram, if operation latencies should be measured -- nullptr if not
+    PerformanceCounters::Values*              performanceCounters; // this thread's counts, if performance counters should be measured -- nullptr if not
+    AllocationTracker::Values*                allocations;      // this thread's heap allocations, if they should be tracked -- nullptr if not
+    OperationTimeline*                        timeline;         // shared by all threads, if each operation's duration should be recorded -- nullptr if not
+    int                                       threads;          // how many threads run the phase -- for the timeline's data set size estimation
+    const unsigned int*                       keys;             // the pass' element of each operation, if not sequential -- nullptr if sequential
+    vector<LockStatistics::Values>*           lockStatistics;   // this thread's instrumented lock counts, if they should be collected -- nullptr if not
+
+    AlgorithmAnalysisSplitRun(int threadNumber, int perThreadNumberOfOperations, AlgorithmComplexityAndReentrancyAnalysis* algorithms, unsigned int firstElement)
             : SplitRun(threadNumber)
             , threadNumber               (threadNumber)
             , perThreadNumberOfOperations(perThreadNumberOfOperations)
             , algorithms                 (algorithms)
-            , pass                       (pass)
-            , perPassNumberOfElements    (perPassNumberOfElements) {}
+            , firstElement               (firstElement)
+            , latencyHistogram           (nullptr)
+            , performanceCounters        (nullptr)
+            , allocations                (nullptr)
+            , timeline                   (nullptr)
+            , threads                    (1)
+            , keys                       (nullptr)
+            , lockStatistics             (nullptr) {}
+
+    /** Calls 'rangeAlgorithm(begin, end)' once for this thread's slice of elements -- or once for each element, recording each call's
+      * latency, if 'latencyHistogram' or 'timeline' are set. On the timeline, the i-th operation of each thread is taken to happen when
+      * the data set had 'firstElement + threads*i + threadNumber' elements -- exact for a single thread, a fair estimate for more.
+      * If 'keys' is set, each operation works on the element mapped from its index -- with one call for each element */
+    template <typename RangeAlgorithm>
+    void runOperations(RangeAlgorithm rangeAlgorithm) {
+        unsigned int begin = firstElement + (perThreadNumberOfOperations*threadNumber);
+        unsigned int end   = firstElement + (perThreadNumberOfOperations*(threadNumber+1));
+        algorithms->getThreadPlacement().pinCurrentThread(threadNumber);
+        vector<LockStatistics::Values>  locksBefore = lockStatistics == nullptr ? vector<LockStatistics::Values>() : LockStatistics::threadSnapshot();
+        unique_ptr<PerformanceCounters> counters(performanceCounters == nullptr ? nullptr : new PerformanceCounters());
+        if (counters) {
+            counters->start();
+        }
+        if (allocations != nullptr) {
+            AllocationTracker::start();
+        }
+        if ( (latencyHistogram == nullptr) && (timeline == nullptr) && (keys == nullptr) ) {
+            rangeAlgorithm(begin, end);
+        } else if ( (latencyHistogram == nullptr) && (timeline == nullptr) ) {
+            for (unsigned int i=begin; i<end; i++) {
+                unsigned int key = keys[i - firstElement];
+                rangeAlgorithm(key, key+1);
+            }
+        } else {
+            const PrecisionClock& clock = algorithms->getClock();
+            unsigned int          n     = firstElement + threadNumber;
+            for (unsigned int i=begin; i<end; i++) {
+                unsigned int       key    = keys == nullptr ? i : keys[i - firstElement];
+                unsigned long long start  = clock.start();
+                rangeAlgorithm(key, key+1);
+                unsigned long long finish = clock.stop();
+                unsigned long long ns     = (unsigned long long)clock.elapsedNS(start, finish);
+                if (latencyHistogram != nullptr) {
+                    latencyHistogram->record(ns);
+                }
+                if (timeline != nullptr) {
+                    timeline->record(n, ns);
+                    n += threads;
+                }
+            }
+        }
+        if (allocations != nullptr) {
+            *allocations = AllocationTracker::stop();
+        }
+        if (counters) {
+            *performanceCounters = counters->stop();
+        }
+        if (lockStatistics != nullptr) {
+            LockStatistics::accumulateDifference(*lockStatistics, LockStatistics::threadSnapshot(), locksBefore);
+        }
+    }
 };
 
-/** Warm up tasks inserts 1% of the total inserts */
+/** Warm up tasks run batches of inserts, selects, updates & deletes on their own elements -- leaving the tables as they found them -- timing
+  * each batch, until the coefficient of variation of the latest 'windowBatches' batch times is at most 'maximumCoefficientOfVariation'.
+  * Settled threads keep running until all of them settled -- so each one is timed under the others' load -- or their elements or the
+  * time budget run out */
 class WarmUpSplitRun: public AlgorithmAnalysisSplitRun {
 public:
-    WarmUpSplitRun(int threadNumber, int perThreadNumberOfOperations, AlgorithmComplexityAndReentrancyAnalysis* algorithms)
-        : AlgorithmAnalysisSplitRun(threadNumber, perThreadNumberOfOperations, algorithms, -1, -1) {}
+    static constexpr unsigned int maximumBatchSize = 32;
+
+    double             maximumCoefficientOfVariation;
+    unsigned int       windowBatches;
+    unsigned long long deadlineUS;
+    atomic<int>*       unsettledThreads;            // shared by all warm up tasks
+    vector<double>     batchNS;                     // ring of the latest 'windowBatches' batch times -- preallocated
+
+    // results
+    unsigned long long operations;
+    bool               steady;
+    double             coefficientOfVariation;
+
+    WarmUpSplitRun(int threadNumber, int perThreadNumberOfOperations, AlgorithmComplexityAndReentrancyAnalysis* algorithms, unsigned int firstElement,
+                   double maximumCoefficientOfVariation, unsigned int windowBatches, unsigned long long deadlineUS, atomic<int>* unsettledThreads)
+            : AlgorithmAnalysisSplitRun(threadNumber, perThreadNumberOfOperations, algorithms, firstElement)
+            , maximumCoefficientOfVariation(maximumCoefficientOfVariation)
+            , windowBatches   (windowBatches)
+            , deadlineUS      (deadlineUS)
+            , unsettledThreads(unsettledThreads)
+            , batchNS         (windowBatches)
+            , operations      (0)
+            , steady          (false)
+            , coefficientOfVariation(NAN) {}
 
     void splitRun() override {
-        for (unsigned int i=perThreadNumberOfOperations*threadNumber; i<perThreadNumberOfOperations*(threadNumber+1)/100; i++) {
-            algorithms->insertAlgorithm(i);
+        algorithms->getThreadPlacement().pinCurrentThread(threadNumber);
+        const PrecisionClock& clock     = algorithms->getClock();
+        unsigned int          batchSize = std::max(1u, std::min(maximumBatchSize, (unsigned int)perThreadNumberOfOperations / (windowBatches*4)));
+        unsigned int          next      = firstElement + (perThreadNumberOfOperations*threadNumber);
+        unsigned int          end       = firstElement + (perThreadNumberOfOperations*(threadNumber+1));
+        bool                  settled   = false;
+        auto settle = [this, &settled]() {
+            if (!settled) {
+                settled = true;
+                unsettledThreads->fetch_sub(1, memory_order_relaxed);
+            }
+        };
+        try {
+            for (unsigned int batches=0; unsettledThreads->load(memory_order_relaxed) > 0; batches++) {
+                if ( (next + batchSize > end) || (TimeMeasurements::getMonotonicRealTimeUS() > deadlineUS) ) {
+                    break;
+                }
+                unsigned long long start = clock.start();
+                algorithms->insertRange(next, next + batchSize);
+                algorithms->selectRange(next, next + batchSize);
+                algorithms->updateRange(next, next + batchSize);
+                algorithms->deleteRange(next, next + batchSize);
+                unsigned long long stop  = clock.stop();
+                next       += batchSize;
+                operations += 4*batchSize;
+                batchNS[batches % windowBatches] = clock.elapsedNS(start, stop);
+                if ( (!settled) && (batches+1 >= windowBatches) ) {
+                    double mean = accumulate(batchNS.begin(), batchNS.end(), 0.0) / windowBatches;
+                    double sumOfSquares = 0.0;
+                    for (double ns : batchNS) {
+                        sumOfSquares += (ns - mean) * (ns - mean);
+                    }
+                    coefficientOfVariation = mean > 0.0 ? sqrt(sumOfSquares / (windowBatches - 1)) / mean : 0.0;
+                    if (coefficientOfVariation <= maximumCoefficientOfVariation) {
+                        steady = true;
+                        settle();
+                    }
+                }
+            }
+        } catch (...) {
+            settle();
+            throw;
         }
+        settle();
     }
 };
 
 class InsertSplitRun: public AlgorithmAnalysisSplitRun {
 public:
-    InsertSplitRun(int threadNumber, int perThreadNumberOfOperations, AlgorithmComplexityAndReentrancyAnalysis* algorithms, int pass, int perPassNumberOfElements)
-            : AlgorithmAnalysisSplitRun(threadNumber, perThreadNumberOfOperations, algorithms, pass, perPassNumberOfElements) {}
+    static constexpr EKeyMapping keyMapping = EKeyMapping::PERMUTATION;
+
+    InsertSplitRun(int threadNumber, int perThreadNumberOfOperations, AlgorithmComplexityAndReentrancyAnalysis* algorithms, unsigned int firstElement)
+            : AlgorithmAnalysisSplitRun(threadNumber, perThreadNumberOfOperations, algorithms, firstElement) {}
 
     void splitRun() override {
-        for (unsigned int i=((perPassNumberOfElements*(pass-1))+(perThreadNumberOfOperations*threadNumber)); i<((perPassNumberOfElements*(pass-1))+(perThreadNumberOfOperations*(threadNumber+1))); i++) {
-            algorithms->insertAlgorithm(i);
-        }
+        runOperations([this](unsigned int begin, unsigned int end) { algorithms->insertRange(begin, end); });
     }
 };
 
 class SelectSplitRun: public AlgorithmAnalysisSplitRun {
 public:
-    SelectSplitRun(int threadNumber, int perThreadNumberOfOperations, AlgorithmComplexityAndReentrancyAnalysis* algorithms, int pass, int perPassNumberOfElements)
-            : AlgorithmAnalysisSplitRun(threadNumber, perThreadNumberOfOperations, algorithms, pass, perPassNumberOfElements) {}
+    static constexpr EKeyMapping keyMapping = EKeyMapping::SAMPLE;
+
+    SelectSplitRun(int threadNumber, int perThreadNumberOfOperations, AlgorithmComplexityAndReentrancyAnalysis* algorithms, unsigned int firstElement)
+            : AlgorithmAnalysisSplitRun(threadNumber, perThreadNumberOfOperations, algorithms, firstElement) {}
 
     void splitRun() override {
-        for (unsigned int i=((perPassNumberOfElements*(pass-1))+(perThreadNumberOfOperations*threadNumber)); i<((perPassNumberOfElements*(pass-1))+(perThreadNumberOfOperations*(threadNumber+1))); i++) {
-            algorithms->selectAlgorithm(i);
-        }
+        runOperations([this](unsigned int begin, unsigned int end) { algorithms->selectRange(begin, end); });
     }
 };
 
 class UpdateSplitRun: public AlgorithmAnalysisSplitRun {
 public:
-    UpdateSplitRun(int threadNumber, int perThreadNumberOfOperations, AlgorithmComplexityAndReentrancyAnalysis* algorithms, int pass, int perPassNumberOfElements)
-            : AlgorithmAnalysisSplitRun(threadNumber, perThreadNumberOfOperations, algorithms, pass, perPassNumberOfElements) {}
+    static constexpr EKeyMapping keyMapping = EKeyMapping::SAMPLE;
+
+    UpdateSplitRun(int threadNumber, int perThreadNumberOfOperations, AlgorithmComplexityAndReentrancyAnalysis* algorithms, unsigned int firstElement)
+            : AlgorithmAnalysisSplitRun(threadNumber, perThreadNumberOfOperations, algorithms, firstElement) {}
 
     void splitRun() override {
-        for (unsigned int i=((perPassNumberOfElements*(pass-1))+(perThreadNumberOfOperations*threadNumber)); i<((perPassNumberOfElements*(pass-1))+(perThreadNumberOfOperations*(threadNumber+1))); i++) {
-            algorithms->updateAlgorithm(i);
-        }
+        runOperations([this](unsigned int begin, unsigned int end) { algorithms->updateRange(begin, end); });
     }
 };
 
 class DeleteSplitRun: public AlgorithmAnalysisSplitRun {
 public:
-    DeleteSplitRun(int threadNumber, int perThreadNumberOfOperations, AlgorithmComplexityAndReentrancyAnalysis* algorithms, int pass, int perPassNumberOfElements)
-            : AlgorithmAnalysisSplitRun(threadNumber, perThreadNumberOfOperations, algorithms, pass, perPassNumberOfElements) {}
+    static constexpr EKeyMapping keyMapping = EKeyMapping::PERMUTATION;
+
+    DeleteSplitRun(int threadNumber, int perThreadNumberOfOperations, AlgorithmComplexityAndReentrancyAnalysis* algorithms, unsigned int firstElement)
+            : AlgorithmAnalysisSplitRun(threadNumber, perThreadNumberOfOperations, algorithms, firstElement) {}
 
     void splitRun() override {
-        for (unsigned int i=((perPassNumberOfElements*(pass-1))+(perThreadNumberOfOperations*threadNumber)); i<((perPassNumberOfElements*(pass-1))+(perThreadNumberOfOperations*(threadNumber+1))); i++) {
-            algorithms->deleteAlgorithm(i);
-        }
+        runOperations([this](unsigned int begin, unsigned int end) { algorithms->deleteRange(begin, end); });
     }
 };
 
+/** Runs one complexity analysis phase: 'threads' instances of 'SplitRunType', each one operating on 'perThreadNumberOfOperations'
+  * elements, starting at 'firstElement'. If 'latencyHistogram' is given, each thread records its operation latencies on its own
+  * histogram and they are all merged into it at the end -- the same goes for 'performanceCounters' and 'allocations'. If 'timeline' is
+  * given, all threads record their operation durations directly on it, on disjoint slots -- and 'lockStatistics' accumulates what each
+  * thread did on the instrumented locks, see {@link LockStatistics}. Unless the key distribution is sequential,
+  * the elements of the operations are mapped through a table computed here, before the phase is timed -- see {@link KeyDistribution}.
+  * Returns: {(ull)startMicroS, (ull)endMicroS, (vector<string>:) exceptions, exceptionReportMessages} */
+template <typename SplitRunType>
+static tuple<unsigned long long, unsigned long long, vector<string>, vector<string>>
+        runAlgorithmAnalysisPhase(AlgorithmComplexityAndReentrancyAnalysis* algorithms, int threads, unsigned int perThreadNumberOfOperations, unsigned int firstElement,
+                                  LatencyHistogram* latencyHistogram = nullptr, PerformanceCounters::Values* performanceCounters = nullptr,
+                                  AllocationTracker::Values* allocations = nullptr, OperationTimeline* timeline = nullptr,
+                                  vector<LockStatistics::Values>* lockStatistics = nullptr) {
+
+    unsigned long long start, end;
+    vector<string>     exceptions, exceptionReportMessages;
+
+    std::vector<unique_ptr<SplitRunType>> splitRunInstances(threads);
+    std::vector<LatencyHistogram>         perThreadLatencyHistograms(latencyHistogram == nullptr ? 0 : threads);
+    std::vector<PerformanceCounters::Values> perThreadPerformanceCounters(performanceCounters == nullptr ? 0 : threads);
+    std::vector<AllocationTracker::Values>   perThreadAllocations(allocations == nullptr ? 0 : threads);
+    std::vector<vector<LockStatistics::Values>> perThreadLockStatistics(lockStatistics == nullptr ? 0 : threads);
+    std::vector<unsigned int>                keys;
+    const KeyDistribution&                   keyDistribution = algorithms->getKeyDistribution();
+    unsigned int                             operations      = perThreadNumberOfOperations*threads;
+    if ( (!keyDistribution.isSequential()) && (SplitRunType::keyMapping == AlgorithmAnalysisSplitRun::EKeyMapping::PERMUTATION) ) {
+        keys = keyDistribution.permutation(firstElement, operations);
+    } else if ( (!keyDistribution.isSequential()) && (SplitRunType::keyMapping == AlgorithmAnalysisSplitRun::EKeyMapping::SAMPLE) ) {
+        keys = keyDistribution.sample(firstElement + operations, operations);
+    }
+    for (int threadNumber=0; threadNumber<threads; threadNumber++) {
+        splitRunInstances[threadNumber] = unique_ptr<SplitRunType>(new SplitRunType(threadNumber, perThreadNumberOfOperations, algorithms, firstElement));
+        if (latencyHistogram != nullptr) {
+            splitRunInstances[threadNumber]->latencyHistogram = &perThreadLatencyHistograms[threadNumber];
+        }
+        if (performanceCounters != nullptr) {
+            splitRunInstances[threadNumber]->performanceCounters = &perThreadPerformanceCounters[threadNumber];
+        }
+        if (allocations != nullptr) {
+            splitRunInstances[threadNumber]->allocations = &perThreadAllocations[threadNumber];
+        }
+        if (lockStatistics != nullptr) {
+            splitRunInstances[threadNumber]->lockStatistics = &perThreadLockStatistics[threadNumber];
+        }
+        splitRunInstances[threadNumber]->timeline = timeline;
+        splitRunInstances[threadNumber]->threads  = threads;
+        splitRunInstances[threadNumber]->keys     = keys.empty() ? nullptr : keys.data();
+        SplitRun::add(*splitRunInstances[threadNumber]);
+    }
+    start = TimeMeasurements::getMonotonicRealTimeUS();
+    tie(exceptions, exceptionReportMessages) = SplitRun::runAndWaitForAll();
+    end   = TimeMeasurements::getMonotonicRealTimeUS();
+
+    if (latencyHistogram != nullptr) {
+        for (LatencyHistogram& perThreadLatencyHistogram : perThreadLatencyHistograms) {
+            latencyHistogram->merge(perThreadLatencyHistogram);
+        }
+    }
+    if (performanceCounters != nullptr) {
+        for (PerformanceCounters::Values& perThreadCounters : perThreadPerformanceCounters) {
+            *performanceCounters += perThreadCounters;
+        }
+    }
+    if (allocations != nullptr) {
+        for (AllocationTracker::Values& perThreadAllocation : perThreadAllocations) {
+            *allocations += perThreadAllocation;
+        }
+    }
+    if (lockStatistics != nullptr) {
+        for (vector<LockStatistics::Values>& perThreadLocks : perThreadLockStatistics) {
+            LockStatistics::accumulateDifference(*lockStatistics, perThreadLocks, {});
+        }
+    }
+
+    return {start, end, exceptions, exceptionReportMessages};
+}
+
+string AlgorithmComplexityAndReentrancyAnalysis::warmUp(int threads) {
+    vector<unique_ptr<WarmUpSplitRun>> splitRunInstances(threads);
+    atomic<int>                        unsettledThreads(threads);
+
+    resetTablesOnPlacementCpus(EResetOccasion::PRE_WARMUP_RESET);
+
+    unsigned long long start = TimeMeasurements::getMonotonicRealTimeUS();
+    for (int threadNumber=0; threadNumber<threads; threadNumber++) {
+        splitRunInstances[threadNumber] = unique_ptr<WarmUpSplitRun>(new WarmUpSplitRun(threadNumber, inserts / threads, this, 0,
+                                                                                        warmUpMaximumCoefficientOfVariation, warmUpWindowBatches,
+                                                                                        start + (unsigned long long)(warmUpTimeBudgetS * 1'000'000.0), &unsettledThreads));
+        SplitRun::add(*splitRunInstances[threadNumber]);
+    }
+    SplitRun::runAndWaitForAll();       // as before, warm up exceptions are left for the measured passes to report
+    unsigned long long end = TimeMeasurements::getMonotonicRealTimeUS();
+
+    lastWarmUp = {0, end - start, true, 0.0};
+    for (unique_ptr<WarmUpSplitRun>& splitRunInstance : splitRunInstances) {
+        lastWarmUp.operations += splitRunInstance->operations;
+        lastWarmUp.steady      = lastWarmUp.steady && splitRunInstance->steady;
+        if ( isnan(splitRunInstance->coefficientOfVariation) || (splitRunInstance->coefficientOfVariation > lastWarmUp.coefficientOfVariation) ) {
+            lastWarmUp.coefficientOfVariation = splitRunInstance->coefficientOfVariation;
+        }
+    }
+
+    char report[128];
+    snprintf(report, sizeof(report), "Warm Up (%s after %llu ops in %.1fms, batch time CV %.1f%%); ", lastWarmUp.steady ? "steady" : "NOT steady",
+             lastWarmUp.operations, ((double)lastWarmUp.durationUS) / 1000.0, lastWarmUp.coefficientOfVariation * 100.0);
+    return report;
+}
+
 #define OUTPUT_MESSAGE(s) outputMessages.append(s); if (verbose) cerr << s << flush
 tuple<string,                                                                                                                                                                             // output messages
       tuple<AlgorithmComplexityAndReentrancyAnalysis::EAlgorithmComplexity, unsigned long long, unsigned long long, vector<string>, vector<string>, vector<string>, vector<string>>,      // INSERTs
@@ -163,45 +617,47 @@ tuple<string,
         analyseComplexity(bool performWarmUp, int insertThreads, int selectThreads, int updateThreads, int deleteThreads, bool verbose) {
 
     constexpr int        numberOfPasses = 2;
-    unsigned int         perThreadInserts = inserts / numberOfPasses / insertThreads;
-    unsigned int         perThreadSelects = selects / numberOfPasses / selectThreads;
-    unsigned int         perThreadUpdates = updates / numberOfPasses / updateThreads;
-    unsigned int         perThreadDeletes = deletes / numberOfPasses / deleteThreads;
+    // operations with 0 threads are not run
+    unsigned int         perThreadInserts = inserts / numberOfPasses / std::max(insertThreads, 1);
+    unsigned int         perThreadSelects = selects / numberOfPasses / std::max(selectThreads, 1);
+    unsigned int         perThreadUpdates = updates / numberOfPasses / std::max(updateThreads, 1);
+    unsigned int         perThreadDeletes = deletes / numberOfPasses / std::max(deleteThreads, 1);
     unsigned int         numberOfFirstPassInsertElements = inserts / numberOfPasses, numberOfSecondPassInsertElements = inserts;
     unsigned int         numberOfFirstPassSelectElements = selects / numberOfPasses, numberOfSecondPassSelectElements = selects;
     unsigned int         numberOfFirstPassUpdateElements = updates / numberOfPasses, numberOfSecondPassUpdateElements = updates;
     unsigned int         numberOfFirstPassDeleteElements = deletes / numberOfPasses, numberOfSecondPassDeleteElements = deletes;
-    unsigned long long   insertStart[numberOfPasses], insertEnd[numberOfPasses];
-    unsigned long long   selectStart[numberOfPasses], selectEnd[numberOfPasses];
-    unsigned long long   updateStart[numberOfPasses], updateEnd[numberOfPasses];
-    unsigned long long   deleteStart[numberOfPasses], deleteEnd[numberOfPasses];
+    // zeroed, so operations with 0 threads report 0 duration passes
+    unsigned long long   insertStart[numberOfPasses]{}, insertEnd[numberOfPasses]{};
+    unsigned long long   selectStart[numberOfPasses]{}, selectEnd[numberOfPasses]{};
+    unsigned long long   updateStart[numberOfPasses]{}, updateEnd[numberOfPasses]{};
+    unsigned long long   deleteStart[numberOfPasses]{}, deleteEnd[numberOfPasses]{};
     vector<string>       insertExceptions[numberOfPasses], insertExceptionReportMessages[numberOfPasses];
     vector<string>       selectExceptions[numberOfPasses], selectExceptionReportMessages[numberOfPasses];
     vector<string>       updateExceptions[numberOfPasses], updateExceptionReportMessages[numberOfPasses];
     vector<string>       deleteExceptions[numberOfPasses], deleteExceptionReportMessages[numberOfPasses];
-    EAlgorithmComplexity insertComplexity;
-    EAlgorithmComplexity selectComplexity;
-    EAlgorithmComplexity updateComplexity;
-    EAlgorithmComplexity deleteComplexity;
+    EAlgorithmComplexity insertComplexity{};
+    EAlgorithmComplexity selectComplexity{};
+    EAlgorithmComplexity updateComplexity{};
+    EAlgorithmComplexity deleteComplexity{};
+    EAlgorithmComplexity insertP99Complexity{}, selectP99Complexity{}, updateP99Complexity{}, deleteP99Complexity{};
     string               algorithmAnalisysReport;
     string               outputMessages = "";
 
+    insertLatencyHistograms = selectLatencyHistograms = updateLatencyHistograms = deleteLatencyHistograms = vector<LatencyHistogram>(measureLatencies ? numberOfPasses : 0);
+    insertPerformanceCounters = selectPerformanceCounters = updatePerformanceCounters = deletePerformanceCounters = vector<PerformanceCounters::Values>(measurePerformanceCounters ? numberOfPasses : 0);
+    insertAllocations           = vector<AllocationTracker::Values>(trackAllocations ? numberOfPasses : 0);
+    insertResidentSetSizeDeltas = vector<long long>(trackAllocations ? numberOfPasses : 0);
+    insertTimeline              = OperationTimeline(recordTimelines && (insertThreads > 0) ? inserts : 0);
+    vector<LockStatistics::Values> insertLocks, selectLocks, updateLocks, deleteLocks;     // of both passes
+
     OUTPUT_MESSAGE(testName + " Algorithm Complexity Analysis: ");
 
     // WARMUP
     if (performWarmUp) {
-    	OUTPUT_MESSAGE("Warm");
-        resetTables(EResetOccasion::PRE_WARMUP_RESET);
-        OUTPUT_MESSAGE(" Up; ");
-        std::vector<unique_ptr<WarmUpSplitRun>> warmUpSplitRunInstances(insertThreads);
-        for (int threadNumber=0; threadNumber<insertThreads; threadNumber++) {
-            warmUpSplitRunInstances[threadNumber] = unique_ptr<WarmUpSplitRun>(new WarmUpSplitRun(threadNumber, perThreadInserts, this));
-            SplitRun::add(*warmUpSplitRunInstances[threadNumber]);
-        }
-        SplitRun::runAndWaitForAll();
+        OUTPUT_MESSAGE(warmUp(insertThreads));
     }
 
-    resetTables(EResetOccasion::FULL_RESET);
+    resetTablesOnPlacementCpus(EResetOccasion::FULL_RESET);
 
     // insert / select / select passes
     //////////////////////////////////
@@ -219,40 +675,36 @@ tuple<string,
         // INSERTS
         if (insertThreads > 0) {
         	OUTPUT_MESSAGE("Insert ");
-            std::vector<unique_ptr<InsertSplitRun>> insertSplitRunInstances(insertThreads);
-            for (int threadNumber=0; threadNumber<insertThreads; threadNumber++) {
-                insertSplitRunInstances[threadNumber] = unique_ptr<InsertSplitRun>(new InsertSplitRun(threadNumber, perThreadInserts, this, pass, numberOfFirstPassInsertElements));
-                SplitRun::add(*insertSplitRunInstances[threadNumber]);
+            unsigned long long residentSetSizeBefore = trackAllocations ? AllocationTracker::getResidentSetSizeBytes() : 0;
+            tie(insertStart[pass-1], insertEnd[pass-1], insertExceptions[pass-1], insertExceptionReportMessages[pass-1]) =
+                runAlgorithmAnalysisPhase<InsertSplitRun>(this, insertThreads, perThreadInserts, numberOfFirstPassInsertElements*(pass-1),
+                                                          measureLatencies ? &insertLatencyHistograms[pass-1] : nullptr,
+                                                          measurePerformanceCounters ? &insertPerformanceCounters[pass-1] : nullptr,
+                                                          trackAllocations ? &insertAllocations[pass-1] : nullptr,
+                                                          recordTimelines ? &insertTimeline : nullptr, &insertLocks);
+            if (trackAllocations) {
+                insertResidentSetSizeDeltas[pass-1] = ((long long)AllocationTracker::getResidentSetSizeBytes()) - ((long long)residentSetSizeBefore);
             }
-            insertStart[pass-1] = TimeMeasurements::getMonotonicRealTimeUS();
-            tie(insertExceptions[pass-1], insertExceptionReportMessages[pass-1]) = SplitRun::runAndWaitForAll();
-            insertEnd[pass-1] = TimeMeasurements::getMonotonicRealTimeUS();
         }
 
         // SELECTS
         if (selectThreads > 0) {
         	OUTPUT_MESSAGE("Select ");
-            std::vector<unique_ptr<SelectSplitRun>> selectSplitRunInstances(selectThreads);
-            for (int threadNumber=0; threadNumber<selectThreads; threadNumber++) {
-                selectSplitRunInstances[threadNumber] = unique_ptr<SelectSplitRun>(new SelectSplitRun(threadNumber, perThreadSelects, this, pass, numberOfFirstPassSelectElements));
-                SplitRun::add(*selectSplitRunInstances[threadNumber]);
-            }
-            selectStart[pass-1] = TimeMeasurements::getMonotonicRealTimeUS();
-            tie(selectExceptions[pass-1], selectExceptionReportMessages[pass-1]) = SplitRun::runAndWaitForAll();
-            selectEnd[pass-1] = TimeMeasurements::getMonotonicRealTimeUS();
+            tie(selectStart[pass-1], selectEnd[pass-1], selectExceptions[pass-1], selectExceptionReportMessages[pass-1]) =
+                runAlgorithmAnalysisPhase<SelectSplitRun>(this, selectThreads, perThreadSelects, numberOfFirstPassSelectElements*(pass-1),
+                                                          measureLatencies ? &selectLatencyHistograms[pass-1] : nullptr,
+                                                          measurePerformanceCounters ? &selectPerformanceCounters[pass-1] : nullptr,
+                                                          nullptr, nullptr, &selectLocks);
         }
 
         // UPDATES
         if (updateThreads > 0) {
         	OUTPUT_MESSAGE("Update ");
-            std::vector<unique_ptr<UpdateSplitRun>> updateSplitRunInstances(updateThreads);
-            for (int threadNumber=0; threadNumber<updateThreads; threadNumber++) {
-                updateSplitRunInstances[threadNumber] = unique_ptr<UpdateSplitRun>(new UpdateSplitRun(threadNumber, perThreadUpdates, this, pass, numberOfFirstPassUpdateElements));
-                SplitRun::add(*updateSplitRunInstances[threadNumber]);
-            }
-            updateStart[pass-1] = TimeMeasurements::getMonotonicRealTimeUS();
-            tie(updateExceptions[pass-1], updateExceptionReportMessages[pass-1]) = SplitRun::runAndWaitForAll();
-            updateEnd[pass-1] = TimeMeasurements::getMonotonicRealTimeUS();
+            tie(updateStart[pass-1], updateEnd[pass-1], updateExceptions[pass-1], updateExceptionReportMessages[pass-1]) =
+                runAlgorithmAnalysisPhase<UpdateSplitRun>(this, updateThreads, perThreadUpdates, numberOfFirstPassUpdateElements*(pass-1),
+                                                          measureLatencies ? &updateLatencyHistograms[pass-1] : nullptr,
+                                                          measurePerformanceCounters ? &updatePerformanceCounters[pass-1] : nullptr,
+                                                          nullptr, nullptr, &updateLocks);
         }
     }
 
@@ -276,14 +728,11 @@ tuple<string,
             }
 
             // DELETES
-            std::vector<unique_ptr<DeleteSplitRun>> deleteSplitRunInstances(deleteThreads);
-            for (int threadNumber=0; threadNumber<deleteThreads; threadNumber++) {
-                deleteSplitRunInstances[threadNumber] = unique_ptr<DeleteSplitRun>(new DeleteSplitRun(threadNumber, perThreadDeletes, this, pass, numberOfFirstPassDeleteElements));
-                SplitRun::add(*deleteSplitRunInstances[threadNumber]);
-            }
-            deleteStart[pass-1] = TimeMeasurements::getMonotonicRealTimeUS();
-            tie(deleteExceptions[pass-1], deleteExceptionReportMessages[pass-1]) = SplitRun::runAndWaitForAll();
-            deleteEnd[pass-1] = TimeMeasurements::getMonotonicRealTimeUS();
+            tie(deleteStart[pass-1], deleteEnd[pass-1], deleteExceptions[pass-1], deleteExceptionReportMessages[pass-1]) =
+                runAlgorithmAnalysisPhase<DeleteSplitRun>(this, deleteThreads, perThreadDeletes, numberOfFirstPassDeleteElements*(pass-1),
+                                                          measureLatencies ? &deleteLatencyHistograms[pass-1] : nullptr,
+                                                          measurePerformanceCounters ? &deletePerformanceCounters[pass-1] : nullptr,
+                                                          nullptr, nullptr, &deleteLocks);
 
         }
 
@@ -292,6 +741,11 @@ tuple<string,
     }
 
     OUTPUT_MESSAGE(".\n");
+    OUTPUT_MESSAGE("Thread placement: " + threadPlacement.toString() + "\n");
+    OUTPUT_MESSAGE("Key distribution: " + keyDistribution.toString() + "\n");
+    if (measureLatencies || recordTimelines) {
+        OUTPUT_MESSAGE("Clock: " + clock.toString() + "\n");
+    }
 
     if (insertThreads > 0) {
         tie(insertComplexity, algorithmAnalisysReport) = computeInsertOrDeleteAlgorithmAnalysis("Insert",
@@ -320,7 +774,128 @@ tuple<string,
         OUTPUT_MESSAGE(algorithmAnalisysReport + "\n");
     }
 
-    resetTables(EResetOccasion::FINAL_RESET);
+    // p99 latencies complexity analysis
+    if (measureLatencies) {
+        if (insertThreads > 0) {
+            OUTPUT_MESSAGE(latencyHistogramsReport("Insert", insertLatencyHistograms, {numberOfFirstPassInsertElements, numberOfSecondPassInsertElements}));
+            // (^t) is the time for n operations at the p99 pace
+            tie(insertP99Complexity, algorithmAnalisysReport) = computeInsertOrDeleteAlgorithmAnalysis("Insert p99 (ns)",
+                                                                                                    0, insertLatencyHistograms[0].getPercentile(99.0)*(inserts/2),
+                                                                                                    0, insertLatencyHistograms[1].getPercentile(99.0)*(inserts/2), inserts/2);
+            OUTPUT_MESSAGE(algorithmAnalisysReport + "\n");
+        }
+        if (selectThreads > 0) {
+            OUTPUT_MESSAGE(latencyHistogramsReport("Select", selectLatencyHistograms, {numberOfFirstPassSelectElements, numberOfSecondPassSelectElements}));
+            tie(selectP99Complexity, algorithmAnalisysReport) = computeSelectOrUpdateAlgorithmAnalysis("Select p99 (ns)",
+                                                                                                    0, selectLatencyHistograms[0].getPercentile(99.0),
+                                                                                                    0, selectLatencyHistograms[1].getPercentile(99.0),
+                                                                                                    numberOfFirstPassSelectElements, numberOfSecondPassSelectElements, 1);
+            OUTPUT_MESSAGE(algorithmAnalisysReport + "\n");
+        }
+        if (updateThreads > 0) {
+            OUTPUT_MESSAGE(latencyHistogramsReport("Update", updateLatencyHistograms, {numberOfFirstPassUpdateElements, numberOfSecondPassUpdateElements}));
+            tie(updateP99Complexity, algorithmAnalisysReport) = computeSelectOrUpdateAlgorithmAnalysis("Update p99 (ns)",
+                                                                                                    0, updateLatencyHistograms[0].getPercentile(99.0),
+                                                                                                    0, updateLatencyHistograms[1].getPercentile(99.0),
+                                                                                                    numberOfFirstPassUpdateElements, numberOfSecondPassUpdateElements, 1);
+            OUTPUT_MESSAGE(algorithmAnalisysReport + "\n");
+        }
+        if (deleteThreads > 0) {
+            OUTPUT_MESSAGE(latencyHistogramsReport("Delete", deleteLatencyHistograms, {numberOfFirstPassDeleteElements, numberOfSecondPassDeleteElements}));
+            tie(deleteP99Complexity, algorithmAnalisysReport) = computeInsertOrDeleteAlgorithmAnalysis("Delete p99 (ns)",
+                                                                                                    0, deleteLatencyHistograms[0].getPercentile(99.0)*(deletes/2),
+                                                                                                    0, deleteLatencyHistograms[1].getPercentile(99.0)*(deletes/2), deletes/2);
+            OUTPUT_MESSAGE(algorithmAnalisysReport + "\n");
+        }
+    }
+
+    // amortized vs worst case analysis
+    if (recordTimelines && (insertThreads > 0) && (insertTimeline.size() > 4*amortizedAnalysisFirstN)) {
+        tie(ignore, ignore, algorithmAnalisysReport) = computeAmortizedAlgorithmAnalysis("Insert", insertTimeline);
+        OUTPUT_MESSAGE(algorithmAnalisysReport + "\n");
+    }
+
+    // space complexity analysis
+    if (trackAllocations && (insertThreads > 0)) {
+        unsigned int insertedElements = perThreadInserts*insertThreads;
+        OUTPUT_MESSAGE(allocationsReport(insertAllocations, insertResidentSetSizeDeltas, {insertedElements, insertedElements}));
+        // (^t) is, here, the net bytes allocated by each pass -- released memory counts as none
+        EAlgorithmComplexity spaceComplexity;
+        tie(spaceComplexity, algorithmAnalisysReport) = computeInsertOrDeleteAlgorithmAnalysis("Insert space (bytes)",
+                                                                                               0, (unsigned long)std::max(insertAllocations[0].getNetBytes(), 0LL),
+                                                                                               0, (unsigned long)std::max(insertAllocations[1].getNetBytes(), 0LL), insertedElements);
+        OUTPUT_MESSAGE(algorithmAnalisysReport + "\n");
+    }
+
+    // performance counters complexity analysis
+    if (measurePerformanceCounters) {
+        if (insertThreads > 0) {
+            OUTPUT_MESSAGE(performanceCountersReport("Insert", insertPerformanceCounters, {perThreadInserts*insertThreads, perThreadInserts*insertThreads},
+                [&](const string& counterName, const vector<unsigned long long>& counts) {
+                    return get<0>(computeInsertOrDeleteAlgorithmAnalysis(counterName, 0, counts[0], 0, counts[1], perThreadInserts*insertThreads));
+                }));
+        }
+        if (selectThreads > 0) {
+            OUTPUT_MESSAGE(performanceCountersReport("Select", selectPerformanceCounters, {perThreadSelects*selectThreads, perThreadSelects*selectThreads},
+                [&](const string& counterName, const vector<unsigned long long>& counts) {
+                    return get<0>(computeSelectOrUpdateAlgorithmAnalysis(counterName, 0, counts[0], 0, counts[1],
+                                                                         numberOfFirstPassSelectElements, numberOfSecondPassSelectElements, perThreadSelects*selectThreads));
+                }));
+        }
+        if (updateThreads > 0) {
+            OUTPUT_MESSAGE(performanceCountersReport("Update", updatePerformanceCounters, {perThreadUpdates*updateThreads, perThreadUpdates*updateThreads},
+                [&](const string& counterName, const vector<unsigned long long>& counts) {
+                    return get<0>(computeSelectOrUpdateAlgorithmAnalysis(counterName, 0, counts[0], 0, counts[1],
+                                                                         numberOfFirstPassUpdateElements, numberOfSecondPassUpdateElements, perThreadUpdates*updateThreads));
+                }));
+        }
+        if (deleteThreads > 0) {
+            OUTPUT_MESSAGE(performanceCountersReport("Delete", deletePerformanceCounters, {perThreadDeletes*deleteThreads, perThreadDeletes*deleteThreads},
+                [&](const string& counterName, const vector<unsigned long long>& counts) {
+                    return get<0>(computeInsertOrDeleteAlgorithmAnalysis(counterName, 0, counts[0], 0, counts[1], perThreadDeletes*deleteThreads));
+                }));
+        }
+    }
+
+    // instrumented locks contention -- the threads' time is their number times the duration of both passes
+    auto threadsNS = [](int threads, const unsigned long long start[], const unsigned long long end[]) {
+        return threads == 0 ? 0ull : ((unsigned long long)threads) * ((end[0] - start[0]) + (end[1] - start[1])) * 1000ull;
+    };
+    OUTPUT_MESSAGE(LockStatistics::report("Insert", insertLocks, 2ull*perThreadInserts*insertThreads, threadsNS(insertThreads, insertStart, insertEnd)));
+    OUTPUT_MESSAGE(LockStatistics::report("Select", selectLocks, 2ull*perThreadSelects*selectThreads, threadsNS(selectThreads, selectStart, selectEnd)));
+    OUTPUT_MESSAGE(LockStatistics::report("Update", updateLocks, 2ull*perThreadUpdates*updateThreads, threadsNS(updateThreads, updateStart, updateEnd)));
+    OUTPUT_MESSAGE(LockStatistics::report("Delete", deleteLocks, 2ull*perThreadDeletes*deleteThreads, threadsNS(deleteThreads, deleteStart, deleteEnd)));
+
+    // structured result
+    auto twoPassesOperationResult = [this](const string& name, int threads, EAlgorithmComplexity complexity, EAlgorithmComplexity p99Complexity,
+                                           const unsigned long long start[], const unsigned long long end[],
+                                           const vector<unsigned int>& firstNs, const vector<unsigned int>& lastNs, unsigned int operations, const vector<string> exceptions[]) {
+        ComplexityAnalysisResult::Operation operation{name, threads, complexity, NAN, NAN, measureLatencies, p99Complexity, NAN, {}, {}};
+        for (int pass=1; (threads > 0) && (pass <= numberOfPasses); pass++) {
+            operation.passes.push_back({firstNs[pass-1], lastNs[pass-1], operations, end[pass-1] - start[pass-1]});
+            operation.exceptions.insert(operation.exceptions.end(), exceptions[pass-1].begin(), exceptions[pass-1].end());
+        }
+        return operation;
+    };
+    unsigned int insertedElements = perThreadInserts*insertThreads;
+    unsigned int deletedElements  = perThreadDeletes*deleteThreads;
+    lastComplexityAnalysisResult = newComplexityAnalysisResult("two passes");
+    lastComplexityAnalysisResult.operations = {
+        twoPassesOperationResult("Insert", insertThreads, insertComplexity, insertP99Complexity, insertStart, insertEnd,
+                                 {0, numberOfFirstPassInsertElements}, {insertedElements, numberOfFirstPassInsertElements+insertedElements},
+                                 insertedElements, insertExceptions),
+        twoPassesOperationResult("Select", selectThreads, selectComplexity, selectP99Complexity, selectStart, selectEnd,
+                                 {numberOfFirstPassSelectElements, numberOfSecondPassSelectElements}, {numberOfFirstPassSelectElements, numberOfSecondPassSelectElements},
+                                 perThreadSelects*selectThreads, selectExceptions),
+        twoPassesOperationResult("Update", updateThreads, updateComplexity, updateP99Complexity, updateStart, updateEnd,
+                                 {numberOfFirstPassUpdateElements, numberOfSecondPassUpdateElements}, {numberOfFirstPassUpdateElements, numberOfSecondPassUpdateElements},
+                                 perThreadUpdates*updateThreads, updateExceptions),
+        twoPassesOperationResult("Delete", deleteThreads, deleteComplexity, deleteP99Complexity, deleteStart, deleteEnd,
+                                 {deletedElements, numberOfFirstPassDeleteElements+deletedElements}, {0, numberOfFirstPassDeleteElements},
+                                 deletedElements, deleteExceptions),
+    };
+
+    resetTablesOnPlacementCpus(EResetOccasion::FINAL_RESET);
 
     return {
     	outputMessages,
@@ -332,143 +907,1696 @@ tuple<string,
 }
 #undef OUTPUT_MESSAGE
 
+#define OUTPUT_MESSAGE(s) outputMessages.append(s); if (verbose) cerr << s << flush
+tuple<string, int, bool,
+      tuple<AlgorithmComplexityAndReentrancyAnalysis::EAlgorithmComplexity, double, double, double, double>,      // INSERTs
+      tuple<AlgorithmComplexityAndReentrancyAnalysis::EAlgorithmComplexity, double, double, double, double>,      // SELECTs
+      tuple<AlgorithmComplexityAndReentrancyAnalysis::EAlgorithmComplexity, double, double, double, double>,      // UPDATEs
+      tuple<AlgorithmComplexityAndReentrancyAnalysis::EAlgorithmComplexity, double, double, double, double>       // DELETEs
+> AlgorithmComplexityAndReentrancyAnalysis::
+        analyseComplexityTrials(bool performWarmUp, int insertThreads, int selectThreads, int updateThreads, int deleteThreads,
+                                double maximumRelativeWidth, double timeBudgetS, int minimumTrials, bool verbose) {
+
+    constexpr int      numberOfResamples = 1000;
+    const string       operationNames[4] = {"Insert", "Select", "Update", "Delete"};
+    const int          threads[4]        = {insertThreads, selectThreads, updateThreads, deleteThreads};
+    vector<double>     deltaT1s[4], deltaT2s[4];        // the per trial pass durations of each operation
+    mt19937            random(0);                       // reproducible resamples
+    string             outputMessages    = "";
+
+    // classifies the two passes durations 'deltaT1' & 'deltaT2' of operation #'operation' just like 'analyseComplexity' does
+    // (durations are scaled from microseconds so the means' fractions are kept)
+    auto classify = [this](int operation, double deltaT1, double deltaT2) {
+        unsigned long int end1 = (unsigned long int)(deltaT1*1000.0), end2 = (unsigned long int)(deltaT2*1000.0);
+        switch (operation) {
+            case 0:  return get<0>(computeInsertOrDeleteAlgorithmAnalysis("Insert", 0, end1, 0, end2, inserts/2));
+            case 1:  return get<0>(computeSelectOrUpdateAlgorithmAnalysis("Select", 0, end1, 0, end2, selects/2, selects, selects));
+            case 2:  return get<0>(computeSelectOrUpdateAlgorithmAnalysis("Update", 0, end1, 0, end2, updates/2, updates, updates));
+            default: return get<0>(computeInsertOrDeleteAlgorithmAnalysis("Delete", 0, end1, 0, end2, deletes/2));
+        }
+    };
 
-class ReentrancySplitRunTest: public SplitRun {
-public:
-    AlgorithmComplexityAndReentrancyAnalysis* algorithms;
-    int                                       op;           // {operations: 0: insert, 1: select, 2: update, 3: delete}
-    std::mutex                                opGuard;
-    unsigned int                              numberOfElements;
-    unsigned int                              verbosityFactor;
-    unsigned int                              insertIndex;
-    unsigned int                              selectIndex;
-    unsigned int                              updateIndex;
-    unsigned int                              deleteIndex;
-    unsigned long long int                    timeusSpentInserting;
-    unsigned long long int                    timeusSpentTestingInsertsAndSelecting;
-    unsigned long long int                    timeusSpentUpdating;
-    unsigned long long int                    timeusSpentTestingUpdatesAndDeleting;
-    string&                                   testOutput;
-
-    ReentrancySplitRunTest(AlgorithmComplexityAndReentrancyAnalysis* algorithms, unsigned int numberOfElements, unsigned int verbosityFactor, string& testOutput)
-            : SplitRun(-1)
-            , algorithms(algorithms)
-            , numberOfElements(numberOfElements)
-            , verbosityFactor(verbosityFactor)
-            , op(0)
-            , timeusSpentInserting                 (0ull)
-            , timeusSpentTestingInsertsAndSelecting(0ull)
-            , timeusSpentUpdating                  (0ull)
-            , timeusSpentTestingUpdatesAndDeleting (0ull)
-    		, testOutput(testOutput) {}
+    // paired bootstrap of the ratio of the mean pass durations of operation #'operation', given the 'resampleAction' to apply to each resample's means
+    auto bootstrap = [&](int operation, auto resampleAction) {
+        size_t trials = deltaT1s[operation].size();
+        uniform_int_distribution<size_t> pick(0, trials-1);
+        for (int resample=0; resample<numberOfResamples; resample++) {
+            double sum1 = 0.0, sum2 = 0.0;
+            for (size_t i=0; i<trials; i++) {
+                size_t trial = pick(random);
+                sum1 += deltaT1s[operation][trial];
+                sum2 += deltaT2s[operation][trial];
+            }
+            resampleAction(sum1/trials, sum2/trials);
+        }
+    };
 
-    void output(const char* op) {
-    	testOutput.append(op);
-    	cerr << op << flush;
-    }
+    // returns the ratio of the mean durations & its 95% confidence interval: {ratio, low, high}
+    auto ratioConfidenceInterval = [&](int operation) -> tuple<double, double, double> {
+        vector<double> ratios;
+        bootstrap(operation, [&ratios](double mean1, double mean2) { ratios.push_back(mean1 > 0.0 ? mean2/mean1 : 0.0); });
+        sort(ratios.begin(), ratios.end());
+        double mean1 = accumulate(deltaT1s[operation].begin(), deltaT1s[operation].end(), 0.0) / deltaT1s[operation].size();
+        double mean2 = accumulate(deltaT2s[operation].begin(), deltaT2s[operation].end(), 0.0) / deltaT2s[operation].size();
+        return {mean1 > 0.0 ? mean2/mean1 : 0.0, ratios[(size_t)(numberOfResamples*0.025)], ratios[(size_t)(numberOfResamples*0.975)-1]};
+    };
 
-    void splitRun() override {
-        opGuard.lock();
-        int operation = op++;
-        opGuard.unlock();
-        if (operation  == 0) {                    // INSERT
-            for (insertIndex=0; insertIndex<numberOfElements; insertIndex++) {
-                if (verbosityFactor && (insertIndex % verbosityFactor == 0)) output("I");
-                unsigned long long int start  = TimeMeasurements::getMonotonicRealTimeUS();
-                algorithms->insertAlgorithm(insertIndex);
-                unsigned long long int finish = TimeMeasurements::getMonotonicRealTimeUS();
-                timeusSpentInserting += finish-start;
-            }
-        } else if (operation == 1) {             // SELECT
-            for (selectIndex=0; selectIndex<numberOfElements; selectIndex++) {
-                while (selectIndex >= insertIndex) this_thread::sleep_for(chrono::milliseconds(100));
-                if (verbosityFactor && (selectIndex % verbosityFactor == 0)) output("S");
-                unsigned long long start  = TimeMeasurements::getMonotonicRealTimeUS();
-                algorithms->selectAlgorithm(selectIndex);
-                unsigned long long finish = TimeMeasurements::getMonotonicRealTimeUS();
-                timeusSpentTestingInsertsAndSelecting += finish-start;
+    OUTPUT_MESSAGE(testName + " Algorithm Complexity Trials: ");
+
+    unsigned long long start     = TimeMeasurements::getMonotonicRealTimeUS();
+    int                trials    = 0;
+    bool               converged = false;
+    while (true) {
+        auto [analysisOutput, insertResult, selectResult, updateResult, deleteResult] =
+            analyseComplexity(performWarmUp && (trials == 0), insertThreads, selectThreads, updateThreads, deleteThreads, false);
+        unsigned long long passDurations[4][2] = {
+            {get<1>(insertResult), get<2>(insertResult)}, {get<1>(selectResult), get<2>(selectResult)},
+            {get<1>(updateResult), get<2>(updateResult)}, {get<1>(deleteResult), get<2>(deleteResult)},
+        };
+        for (int operation=0; operation<4; operation++) {
+            if (threads[operation] > 0) {
+                deltaT1s[operation].push_back((double)passDurations[operation][0]);
+                deltaT2s[operation].push_back((double)passDurations[operation][1]);
             }
-        } else if (operation == 2) {             // UPDATE
-            for (updateIndex=0; updateIndex<numberOfElements; updateIndex++) {
-                while (updateIndex >= selectIndex) this_thread::sleep_for(chrono::milliseconds(100));
-                if (verbosityFactor && (updateIndex % verbosityFactor == 0)) output("U");
-                unsigned long long start  = TimeMeasurements::getMonotonicRealTimeUS();
-                algorithms->updateAlgorithm(updateIndex);
-                unsigned long long finish = TimeMeasurements::getMonotonicRealTimeUS();
-                timeusSpentUpdating += finish-start;
+        }
+        trials++;
+        OUTPUT_MESSAGE(".");
+
+        if (trials >= std::max(minimumTrials, 2)) {
+            converged = true;
+            for (int operation=0; operation<4; operation++) {
+                if (threads[operation] > 0) {
+                    auto [ratio, low, high] = ratioConfidenceInterval(operation);
+                    converged = converged && (ratio > 0.0) && ((high - low) / ratio <= maximumRelativeWidth);
+                }
             }
-        } else if (operation == 3) {             // DELETE
-            for (deleteIndex=0; deleteIndex<numberOfElements; deleteIndex++) {
-                while (deleteIndex >= updateIndex) this_thread::sleep_for(chrono::milliseconds(100));
-                if (verbosityFactor && (deleteIndex % verbosityFactor == 0)) output("D");
-                unsigned long long start  = TimeMeasurements::getMonotonicRealTimeUS();
-                algorithms->deleteAlgorithm(deleteIndex);
-                unsigned long long finish = TimeMeasurements::getMonotonicRealTimeUS();
-                timeusSpentTestingUpdatesAndDeleting += finish-start;
+            if ( converged || ((TimeMeasurements::getMonotonicRealTimeUS() - start) >= timeBudgetS*1'000'000.0) ) {
+                break;
             }
-        } else {
-            THROW_EXCEPTION(std::runtime_error, "unknown operation #" + to_string(operation));
         }
     }
-};
+    OUTPUT_MESSAGE(" " + to_string(trials) + " trials -- " + (converged ? "converged" : "time budget exhausted") + ".\n");
+
+    // verdicts
+    tuple<EAlgorithmComplexity, double, double, double, double> verdicts[4];
+    for (int operation=0; operation<4; operation++) {
+        if (threads[operation] <= 0) {
+            // not run: NaNs, rather than a confident verdict
+            verdicts[operation] = {EAlgorithmComplexity::O1, NAN, NAN, NAN, NAN};
+            OUTPUT_MESSAGE(operationNames[operation] + ": not run (0 threads)\n");
+            continue;
+        }
+        double mean1 = accumulate(deltaT1s[operation].begin(), deltaT1s[operation].end(), 0.0) / trials;
+        double mean2 = accumulate(deltaT2s[operation].begin(), deltaT2s[operation].end(), 0.0) / trials;
+        EAlgorithmComplexity complexity = classify(operation, mean1, mean2);
+        int                  agreements = 0;
+        bootstrap(operation, [&](double resampleMean1, double resampleMean2) {
+            if (classify(operation, resampleMean1, resampleMean2) == complexity) agreements++;
+        });
+        double confidence        = ((double)agreements) / ((double)numberOfResamples);
+        auto [ratio, low, high]  = ratioConfidenceInterval(operation);
+        verdicts[operation]      = {complexity, confidence, ratio, low, high};
+        OUTPUT_MESSAGE(operationNames[operation] + ": " + EAlgorithmComplexityToString(complexity) + " with " + to_string(confidence*100.0) + "% confidence -- " +
+                       "t2/t1 = " + to_string(ratio) + ", 95% CI [" + to_string(low) + ", " + to_string(high) + "]\n");
+    }
 
-#define OUTPUT_MESSAGE(s) outputMessages.append(s); if (verbose) cerr << s << flush
-string AlgorithmComplexityAndReentrancyAnalysis::
-		testReentrancy(unsigned int numberOfElements, bool verbose) {
+    return {outputMessages, trials, converged, verdicts[0], verdicts[1], verdicts[2], verdicts[3]};
+}
+#undef OUTPUT_MESSAGE
 
-    string outputMessages = "";
-	OUTPUT_MESSAGE(testName + " Algorithm Reentrancy Tests");
-    resetTables(EResetOccasion::FULL_RESET);
-    OUTPUT_MESSAGE(": ");
+#define OUTPUT_MESSAGE(s) outputMessages.append(s); if (verbose) cerr << s << flush
+tuple<string,                                                                                                                                                     // output messages
+      tuple<AlgorithmComplexityAndReentrancyAnalysis::EAlgorithmComplexity, double, vector<unsigned long long>, vector<string>, vector<string>>,               // INSERTs
+      tuple<AlgorithmComplexityAndReentrancyAnalysis::EAlgorithmComplexity, double, vector<unsigned long long>, vector<string>, vector<string>>,               // SELECTs
+      tuple<AlgorithmComplexityAndReentrancyAnalysis::EAlgorithmComplexity, double, vector<unsigned long long>, vector<string>, vector<string>>,               // UPDATEs
+      tuple<AlgorithmComplexityAndReentrancyAnalysis::EAlgorithmComplexity, double, vector<unsigned long long>, vector<string>, vector<string>>                // DELETEs
+> AlgorithmComplexityAndReentrancyAnalysis::
+        analyseComplexitySweep(bool performWarmUp, int numberOfSizes, int insertThreads, int selectThreads, int updateThreads, int deleteThreads, bool verbose) {
 
-    ReentrancySplitRunTest reentrancyTest(this, numberOfElements, verbose ? numberOfElements/4 : 0, outputMessages);
+    if ( (numberOfSizes < 2) || ((inserts >> (numberOfSizes-1)) == 0) ) {
+        THROW_EXCEPTION(std::invalid_argument, "Cannot sweep " + to_string(numberOfSizes) + " data set sizes up to " + to_string(inserts) + " elements: " +
+                                               "at least 2 sizes, with at least 1 element on the smallest one, are required");
+    }
 
-    // prepare the simultaneous tasks
-    //for (unsigned int threadSet=0; threadSet<numberOfThreadSets; threadSet++) {
-        SplitRun::add(reentrancyTest);  // INSERT
-        SplitRun::add(reentrancyTest);  // SELECT
-        SplitRun::add(reentrancyTest);  // UPDATE
-        SplitRun::add(reentrancyTest);  // DELETE
-    //}
+    // data set sizes at the end of each pass: n, 2n, 4n, ..., 'inserts'
+    vector<unsigned int> sizes(numberOfSizes);
+    for (int pass=1; pass<=numberOfSizes; pass++) {
+        sizes[pass-1] = inserts >> (numberOfSizes-pass);
+    }
+    // selects & updates operate on the last elements of each data set size, so they are limited by the smallest one
+    unsigned int         perPassSelects = std::min((unsigned int)selects / numberOfSizes, sizes[0]);
+    unsigned int         perPassUpdates = std::min((unsigned int)updates / numberOfSizes, sizes[0]);
+
+    vector<unsigned long long> insertDeltaTs, selectDeltaTs, updateDeltaTs, deleteDeltaTs;
+    vector<unsigned int>       insertFirstNs, selectFirstNs, updateFirstNs, deleteFirstNs;
+    vector<unsigned int>       insertLastNs,  selectLastNs,  updateLastNs,  deleteLastNs;
+    vector<unsigned int>       insertRs,      selectRs,      updateRs,      deleteRs;
+    vector<string>             insertExceptions, insertExceptionReportMessages;
+    vector<string>             selectExceptions, selectExceptionReportMessages;
+    vector<string>             updateExceptions, updateExceptionReportMessages;
+    vector<string>             deleteExceptions, deleteExceptionReportMessages;
+    EAlgorithmComplexity       insertComplexity{}, selectComplexity{}, updateComplexity{}, deleteComplexity{};
+    double                     insertGoodnessOfFit = 0.0, selectGoodnessOfFit = 0.0, updateGoodnessOfFit = 0.0, deleteGoodnessOfFit = 0.0;
+    double                     insertConstant      = NAN, selectConstant      = NAN, updateConstant      = NAN, deleteConstant      = NAN;
+    EAlgorithmComplexity       insertP99Complexity{}, selectP99Complexity{}, updateP99Complexity{}, deleteP99Complexity{};
+    double                     insertP99GoodnessOfFit = NAN, selectP99GoodnessOfFit = NAN, updateP99GoodnessOfFit = NAN, deleteP99GoodnessOfFit = NAN;
+    string                     algorithmAnalisysReport;
+    string                     outputMessages = "";
+
+    // collects the duration & exceptions of a phase into the per pass measurements
+    auto collectPhase = [](const tuple<unsigned long long, unsigned long long, vector<string>, vector<string>>& phase,
+                           vector<unsigned long long>& deltaTs, vector<string>& exceptions, vector<string>& exceptionReportMessages) {
+        auto& [start, end, phaseExceptions, phaseExceptionReportMessages] = phase;
+        deltaTs.push_back(end - start);
+        exceptions.insert(exceptions.end(), phaseExceptions.begin(), phaseExceptions.end());
+        exceptionReportMessages.insert(exceptionReportMessages.end(), phaseExceptionReportMessages.begin(), phaseExceptionReportMessages.end());
+    };
 
-    SplitRun::runAndWaitForAll();
+    insertLatencyHistograms = selectLatencyHistograms = updateLatencyHistograms = deleteLatencyHistograms = vector<LatencyHistogram>(measureLatencies ? numberOfSizes : 0);
+    insertPerformanceCounters = selectPerformanceCounters = updatePerformanceCounters = deletePerformanceCounters = vector<PerformanceCounters::Values>(measurePerformanceCounters ? numberOfSizes : 0);
 
-    OUTPUT_MESSAGE(" Done: ");
-    resetTables(EResetOccasion::FINAL_RESET);
-    OUTPUT_MESSAGE(to_string(reentrancyTest.timeusSpentInserting                  / 1000llu) + "ms inserting, " +
-           to_string(reentrancyTest.timeusSpentTestingInsertsAndSelecting / 1000llu) + "ms selecting & testing, " +
-		   to_string(reentrancyTest.timeusSpentUpdating                   / 1000llu) + "ms updating, " +
-		   to_string(reentrancyTest.timeusSpentTestingUpdatesAndDeleting  / 1000llu) + "ms testing & deleting.\n");
+    OUTPUT_MESSAGE(testName + " Algorithm Complexity Sweep Analysis: ");
 
-    return outputMessages;
-}
-#undef OUTPUT_MESSAGE
+    // WARMUP
+    if (performWarmUp) {
+        OUTPUT_MESSAGE(warmUp(insertThreads));
+    }
 
+    resetTablesOnPlacementCpus(EResetOccasion::FULL_RESET);
 
-#define lPAD12(n) std::to_string(n) + ((n)>99999999999 ? "" : ((n)>9999999999 ? " " : ((n)>999999999 ? "  " : ((n)>99999999 ? "   " : ((n)>9999999 ? "    " : ((n)>999999 ? "     " : ((n)>99999 ? "      " : ((n)>9999 ? "       " : ((n)>999 ? "        " : ((n)>99 ? "         " : ((n)>9 ? "          " : "           ")))))))))))
+    // insert / select / update passes
+    //////////////////////////////////
 
-std::tuple<AlgorithmComplexityAndReentrancyAnalysis::EAlgorithmComplexity, string> AlgorithmComplexityAndReentrancyAnalysis::
-    	computeSelectOrUpdateAlgorithmAnalysis(
-    			const string&            operation,
-				const unsigned long int& start1,
-				const unsigned long int& end1,
-				const unsigned long int& start2,
-				const unsigned long int& end2,
-				const unsigned int       n1,
-				const unsigned int       n2,
-				const unsigned int       r) {
+    for (int pass=1; pass<=numberOfSizes; pass++) {
 
-    // the acceptable percent measurement error when computing complexity
-    double percentError = 0.10;
+        unsigned int previousSize = pass == 1 ? 0 : sizes[pass-2];
+        unsigned int size         = sizes[pass-1];
 
-    unsigned long int deltaT1 = end1 - start1;
-    unsigned long int deltaT2 = end2 - start2;
-    double t1 = ((double)deltaT1) / ((double)r);
-    double t2 = ((double)deltaT2) / ((double)r);
+        OUTPUT_MESSAGE((pass == 1 ? "" : "); ") + string("n=") + to_string(size) + " ( ");
 
-    EAlgorithmComplexity complexity;
+        // INSERTS
+        if (insertThreads > 0) {
+            OUTPUT_MESSAGE("Insert ");
+            unsigned int perThreadInserts = (size - previousSize) / insertThreads;
+            collectPhase(runAlgorithmAnalysisPhase<InsertSplitRun>(this, insertThreads, perThreadInserts, previousSize,
+                                                                   measureLatencies ? &insertLatencyHistograms[pass-1] : nullptr,
+                                                                   measurePerformanceCounters ? &insertPerformanceCounters[pass-1] : nullptr),
+                         insertDeltaTs, insertExceptions, insertExceptionReportMessages);
+            // the remainder of the division among threads -- untimed, so selects & updates, reaching 'size', only find inserted elements
+            insertRange(previousSize + perThreadInserts*insertThreads, size);
+            insertFirstNs.push_back(previousSize);
+            insertLastNs.push_back(previousSize + perThreadInserts*insertThreads);
+            insertRs.push_back(perThreadInserts*insertThreads);
+        }
 
-    // sanity check
+        // SELECTS
+        if (selectThreads > 0) {
+            OUTPUT_MESSAGE("Select ");
+            unsigned int perThreadSelects = perPassSelects / selectThreads;
+            collectPhase(runAlgorithmAnalysisPhase<SelectSplitRun>(this, selectThreads, perThreadSelects, size - perThreadSelects*selectThreads,
+                                                                   measureLatencies ? &selectLatencyHistograms[pass-1] : nullptr,
+                                                                   measurePerformanceCounters ? &selectPerformanceCounters[pass-1] : nullptr),
+                         selectDeltaTs, selectExceptions, selectExceptionReportMessages);
+            selectFirstNs.push_back(size);
+            selectLastNs.push_back(size);
+            selectRs.push_back(perThreadSelects*selectThreads);
+        }
+
+        // UPDATES
+        if (updateThreads > 0) {
+            OUTPUT_MESSAGE("Update ");
+            unsigned int perThreadUpdates = perPassUpdates / updateThreads;
+            collectPhase(runAlgorithmAnalysisPhase<UpdateSplitRun>(this, updateThreads, perThreadUpdates, size - perThreadUpdates*updateThreads,
+                                                                   measureLatencies ? &updateLatencyHistograms[pass-1] : nullptr,
+                                                                   measurePerformanceCounters ? &updatePerformanceCounters[pass-1] : nullptr),
+                         updateDeltaTs, updateExceptions, updateExceptionReportMessages);
+            updateFirstNs.push_back(size);
+            updateLastNs.push_back(size);
+            updateRs.push_back(perThreadUpdates*updateThreads);
+        }
+    }
+
+    OUTPUT_MESSAGE(")");
+
+    // delete passes
+    ////////////////
+
+    if (deleteThreads > 0) {
+
+        OUTPUT_MESSAGE("; Delete ( ");
+
+        for (int pass=numberOfSizes; pass>=1; pass--) {
+
+            unsigned int previousSize = pass == 1 ? 0 : sizes[pass-2];
+            unsigned int size         = sizes[pass-1];
+
+            OUTPUT_MESSAGE("n=" + to_string(size) + " ");
+
+            unsigned int perThreadDeletes = (size - previousSize) / deleteThreads;
+            collectPhase(runAlgorithmAnalysisPhase<DeleteSplitRun>(this, deleteThreads, perThreadDeletes, previousSize,
+                                                                   measureLatencies ? &deleteLatencyHistograms[pass-1] : nullptr,
+                                                                   measurePerformanceCounters ? &deletePerformanceCounters[pass-1] : nullptr),
+                         deleteDeltaTs, deleteExceptions, deleteExceptionReportMessages);
+            // likewise, the remainder of the inserts
+            deleteRange(previousSize + perThreadDeletes*deleteThreads, size);
+            deleteFirstNs.push_back(previousSize + perThreadDeletes*deleteThreads);
+            deleteLastNs.push_back(previousSize);
+            deleteRs.push_back(perThreadDeletes*deleteThreads);
+        }
+
+        // present the delete passes in ascending data set size order, like the others
+        reverse(deleteDeltaTs.begin(), deleteDeltaTs.end());
+        reverse(deleteFirstNs.begin(), deleteFirstNs.end());
+        reverse(deleteLastNs.begin(),  deleteLastNs.end());
+        reverse(deleteRs.begin(),      deleteRs.end());
+
+        OUTPUT_MESSAGE(")");
+
+    }
+
+    OUTPUT_MESSAGE(".\n");
+    OUTPUT_MESSAGE("Thread placement: " + threadPlacement.toString() + "\n");
+    OUTPUT_MESSAGE("Key distribution: " + keyDistribution.toString() + "\n");
+    if (measureLatencies) {
+        OUTPUT_MESSAGE("Clock: " + clock.toString() + "\n");
+    }
+
+    if (insertThreads > 0) {
+        tie(insertComplexity, insertGoodnessOfFit, insertConstant, algorithmAnalisysReport) = computeAlgorithmAnalysisByRegression("Insert", insertDeltaTs, insertFirstNs, insertLastNs, insertRs);
+        OUTPUT_MESSAGE(algorithmAnalisysReport + "\n");
+    }
+    if (selectThreads > 0) {
+        tie(selectComplexity, selectGoodnessOfFit, selectConstant, algorithmAnalisysReport) = computeAlgorithmAnalysisByRegression("Select", selectDeltaTs, selectFirstNs, selectLastNs, selectRs);
+        OUTPUT_MESSAGE(algorithmAnalisysReport + "\n");
+    }
+    if (updateThreads > 0) {
+        tie(updateComplexity, updateGoodnessOfFit, updateConstant, algorithmAnalisysReport) = computeAlgorithmAnalysisByRegression("Update", updateDeltaTs, updateFirstNs, updateLastNs, updateRs);
+        OUTPUT_MESSAGE(algorithmAnalisysReport + "\n");
+    }
+    if (deleteThreads > 0) {
+        tie(deleteComplexity, deleteGoodnessOfFit, deleteConstant, algorithmAnalisysReport) = computeAlgorithmAnalysisByRegression("Delete", deleteDeltaTs, deleteFirstNs, deleteLastNs, deleteRs);
+        OUTPUT_MESSAGE(algorithmAnalisysReport + "\n");
+    }
+
+    // p99 latencies complexity analysis
+    if (measureLatencies) {
+        vector<unsigned int>       ones(numberOfSizes, 1);
+        auto p99s = [](const vector<LatencyHistogram>& histograms) {
+            vector<unsigned long long> p99s;
+            for (const LatencyHistogram& histogram : histograms) {
+                p99s.push_back(histogram.getPercentile(99.0));
+            }
+            return p99s;
+        };
+        if (insertThreads > 0) {
+            OUTPUT_MESSAGE(latencyHistogramsReport("Insert", insertLatencyHistograms, insertLastNs));
+            tie(insertP99Complexity, insertP99GoodnessOfFit, ignore, algorithmAnalisysReport) = computeAlgorithmAnalysisByRegression("Insert p99 (ns)", p99s(insertLatencyHistograms), insertFirstNs, insertLastNs, ones);
+            OUTPUT_MESSAGE(algorithmAnalisysReport + "\n");
+        }
+        if (selectThreads > 0) {
+            OUTPUT_MESSAGE(latencyHistogramsReport("Select", selectLatencyHistograms, selectLastNs));
+            tie(selectP99Complexity, selectP99GoodnessOfFit, ignore, algorithmAnalisysReport) = computeAlgorithmAnalysisByRegression("Select p99 (ns)", p99s(selectLatencyHistograms), selectFirstNs, selectLastNs, ones);
+            OUTPUT_MESSAGE(algorithmAnalisysReport + "\n");
+        }
+        if (updateThreads > 0) {
+            OUTPUT_MESSAGE(latencyHistogramsReport("Update", updateLatencyHistograms, updateLastNs));
+            tie(updateP99Complexity, updateP99GoodnessOfFit, ignore, algorithmAnalisysReport) = computeAlgorithmAnalysisByRegression("Update p99 (ns)", p99s(updateLatencyHistograms), updateFirstNs, updateLastNs, ones);
+            OUTPUT_MESSAGE(algorithmAnalisysReport + "\n");
+        }
+        if (deleteThreads > 0) {
+            OUTPUT_MESSAGE(latencyHistogramsReport("Delete", deleteLatencyHistograms, deleteFirstNs));
+            tie(deleteP99Complexity, deleteP99GoodnessOfFit, ignore, algorithmAnalisysReport) = computeAlgorithmAnalysisByRegression("Delete p99 (ns)", p99s(deleteLatencyHistograms), deleteFirstNs, deleteLastNs, ones);
+            OUTPUT_MESSAGE(algorithmAnalisysReport + "\n");
+        }
+    }
+
+    // performance counters complexity analysis
+    if (measurePerformanceCounters) {
+        auto regression = [](const vector<unsigned int>& firstNs, const vector<unsigned int>& lastNs, const vector<unsigned int>& rs) {
+            return [&firstNs, &lastNs, &rs](const string& counterName, const vector<unsigned long long>& counts) {
+                return get<0>(computeAlgorithmAnalysisByRegression(counterName, counts, firstNs, lastNs, rs));
+            };
+        };
+        if (insertThreads > 0) {
+            OUTPUT_MESSAGE(performanceCountersReport("Insert", insertPerformanceCounters, insertRs, regression(insertFirstNs, insertLastNs, insertRs)));
+        }
+        if (selectThreads > 0) {
+            OUTPUT_MESSAGE(performanceCountersReport("Select", selectPerformanceCounters, selectRs, regression(selectFirstNs, selectLastNs, selectRs)));
+        }
+        if (updateThreads > 0) {
+            OUTPUT_MESSAGE(performanceCountersReport("Update", updatePerformanceCounters, updateRs, regression(updateFirstNs, updateLastNs, updateRs)));
+        }
+        if (deleteThreads > 0) {
+            // the counters are indexed by pass, while the delete measurements were reversed into ascending data set sizes
+            vector<PerformanceCounters::Values> ascendingDeletePerformanceCounters(deletePerformanceCounters.rbegin(), deletePerformanceCounters.rend());
+            OUTPUT_MESSAGE(performanceCountersReport("Delete", ascendingDeletePerformanceCounters, deleteRs, regression(deleteFirstNs, deleteLastNs, deleteRs)));
+        }
+    }
+
+    // structured result
+    auto sweepOperationResult = [this](const string& name, int threads, EAlgorithmComplexity complexity, double goodnessOfFit, double constantUS,
+                                       EAlgorithmComplexity p99Complexity, double p99GoodnessOfFit,
+                                       const vector<unsigned long long>& deltaTs, const vector<unsigned int>& firstNs, const vector<unsigned int>& lastNs,
+                                       const vector<unsigned int>& rs, const vector<string>& exceptions) {
+        ComplexityAnalysisResult::Operation operation{name, threads, complexity, goodnessOfFit, constantUS*1000.0, measureLatencies, p99Complexity, p99GoodnessOfFit, {}, exceptions};
+        for (size_t k=0; k<deltaTs.size(); k++) {
+            operation.passes.push_back({firstNs[k], lastNs[k], rs[k], deltaTs[k]});
+        }
+        return operation;
+    };
+    lastComplexityAnalysisResult = newComplexityAnalysisResult("sweep");
+    lastComplexityAnalysisResult.operations = {
+        sweepOperationResult("Insert", insertThreads, insertComplexity, insertGoodnessOfFit, insertConstant, insertP99Complexity, insertP99GoodnessOfFit, insertDeltaTs, insertFirstNs, insertLastNs, insertRs, insertExceptions),
+        sweepOperationResult("Select", selectThreads, selectComplexity, selectGoodnessOfFit, selectConstant, selectP99Complexity, selectP99GoodnessOfFit, selectDeltaTs, selectFirstNs, selectLastNs, selectRs, selectExceptions),
+        sweepOperationResult("Update", updateThreads, updateComplexity, updateGoodnessOfFit, updateConstant, updateP99Complexity, updateP99GoodnessOfFit, updateDeltaTs, updateFirstNs, updateLastNs, updateRs, updateExceptions),
+        sweepOperationResult("Delete", deleteThreads, deleteComplexity, deleteGoodnessOfFit, deleteConstant, deleteP99Complexity, deleteP99GoodnessOfFit, deleteDeltaTs, deleteFirstNs, deleteLastNs, deleteRs, deleteExceptions),
+    };
+
+    resetTablesOnPlacementCpus(EResetOccasion::FINAL_RESET);
+
+    return {
+        outputMessages,
+        {insertComplexity, insertGoodnessOfFit, insertDeltaTs, insertExceptions, insertExceptionReportMessages},     // INSERTs
+        {selectComplexity, selectGoodnessOfFit, selectDeltaTs, selectExceptions, selectExceptionReportMessages},     // SELECTs
+        {updateComplexity, updateGoodnessOfFit, updateDeltaTs, updateExceptions, updateExceptionReportMessages},     // UPDATEs
+        {deleteComplexity, deleteGoodnessOfFit, deleteDeltaTs, deleteExceptions, deleteExceptionReportMessages}      // DELETEs
+    };
+}
+#undef OUTPUT_MESSAGE
+
+AlgorithmComplexityAndReentrancyAnalysis::MixedWorkload AlgorithmComplexityAndReentrancyAnalysis::MixedWorkload::ycsb(char workload) {
+    switch (toupper((unsigned char)workload)) {
+        case 'A': return {"YCSB A", 0.00, 0.50, 0.50, 0.00, false};
+        case 'B': return {"YCSB B", 0.00, 0.95, 0.05, 0.00, false};
+        case 'C': return {"YCSB C", 0.00, 1.00, 0.00, 0.00, false};
+        case 'D': return {"YCSB D", 0.05, 0.95, 0.00, 0.00, false};
+        case 'F': return {"YCSB F", 0.00, 0.50, 0.50, 0.00, true};
+        case 'E':
+            THROW_EXCEPTION(std::invalid_argument, "YCSB workload E is made of short range scans, which have no counterpart among the insert, select, update & delete operations");
+        default:
+            THROW_EXCEPTION(std::invalid_argument, "Unknown YCSB workload '" + string(1, workload) + "' -- A, B, C, D & F are supported");
+    }
+}
+
+string AlgorithmComplexityAndReentrancyAnalysis::MixedWorkload::toString() const {
+    double total = insertProportion + selectProportion + updateProportion + deleteProportion;
+    char   description[256];
+    snprintf(description, sizeof(description), "%s (%.4g%% inserts, %.4g%% selects, %.4g%% %supdates, %.4g%% deletes)", name.c_str(),
+             insertProportion*100.0/total, selectProportion*100.0/total, updateProportion*100.0/total, readModifyWrite ? "read-modify-write " : "",
+             deleteProportion*100.0/total);
+    return description;
+}
+
+
+/** One thread of a mixed workload: cycles through the operations & keys tables, starting at its own offset, until the deadline -- closed
+  * loop, each operation issued as soon as the previous one returns -- or, if 'intervalNS' is set, open loop: the i-th operation is issued
+  * 'i*intervalNS' after the thread starts (or as soon as possible, if late) and its latency is also measured from that intended start,
+  * so stalls are charged to all the operations they delay -- correcting the coordinated omission of closed loop measurements */
+class MixedWorkloadSplitRun: public SplitRun {
+public:
+    enum EOperation: unsigned char {INSERT, SELECT, UPDATE, DELETE};
+
+    static constexpr unsigned int tableSize = 65536;    // entries of the operations & keys tables -- a power of 2
+
+    const int                                 threadNumber;
+    const int                                 threads;
+    AlgorithmComplexityAndReentrancyAnalysis* algorithms;
+    const vector<unsigned char>&              operations;       // EOperation of each slot
+    const vector<unsigned int>&               keys;             // the preloaded element of each slot -- for selects & updates
+    const bool                                readModifyWrite;
+    const unsigned int                        firstInsertKey;   // this thread inserts 'firstInsertKey + threadNumber + threads*(i % insertWindow)'...
+    const unsigned int                        insertWindow;     // ... keeping at most 'insertWindow' of them present
+    const unsigned long long                  deadlineUS;       // closed loop: when to stop; open loop: when to give up the remaining operations
+    const double                              intervalNS;       // open loop schedule -- 0 for closed loop
+    const unsigned long long                  scheduledOperations;  // open loop operations to issue
+    array<LatencyHistogram, 4>                latencies;        // service times: from the actual start
+    array<LatencyHistogram, 4>                intendedLatencies;    // open loop: from the intended start
+    unsigned long long                        inserted;         // elements this thread inserted...
+    unsigned long long                        deleted;          // ... and deleted -- the oldest first
+    unsigned long long                        startUS;
+    unsigned long long                        endUS;
+    OperationHistory*                         history;          // nullptr if not recording
+
+    MixedWorkloadSplitRun(int threadNumber, int threads, AlgorithmComplexityAndReentrancyAnalysis* algorithms,
+                          const vector<unsigned char>& operations, const vector<unsigned int>& keys, bool readModifyWrite,
+                          unsigned int firstInsertKey, unsigned int insertWindow, unsigned long long deadlineUS,
+                          double intervalNS = 0.0, unsigned long long scheduledOperations = 0)
+            : SplitRun(threadNumber)
+            , threadNumber   (threadNumber)
+            , threads        (threads)
+            , algorithms     (algorithms)
+            , operations     (operations)
+            , keys           (keys)
+            , readModifyWrite(readModifyWrite)
+            , firstInsertKey (firstInsertKey)
+            , insertWindow   (insertWindow)
+            , deadlineUS     (deadlineUS)
+            , intervalNS     (intervalNS)
+            , scheduledOperations(scheduledOperations)
+            , inserted       (0)
+            , deleted        (0)
+            , startUS        (0)
+            , endUS          (0)
+            , history        (nullptr) {}
+
+    unsigned int insertedKey(unsigned long long i) const {
+        return firstInsertKey + threadNumber + threads*(unsigned int)(i % insertWindow);
+    }
+
+    void splitRun() override {
+        algorithms->getThreadPlacement().pinCurrentThread(threadNumber);
+        const PrecisionClock& clock = algorithms->getClock();
+        unsigned int          slot  = (tableSize / threads) * threadNumber;
+        startUS = TimeMeasurements::getMonotonicRealTimeUS();
+        unsigned long long threadStart = clock.start();
+        for (unsigned long long count=0; ; count++, slot = (slot+1) % tableSize) {
+            // reading the time is costlier than most operations
+            if ( ((intervalNS > 0.0) && (count == scheduledOperations)) ||
+                 ((count % 64 == 0) && (TimeMeasurements::getMonotonicRealTimeUS() >= deadlineUS)) ) {
+                break;
+            }
+            double intendedNS = count * intervalNS;
+            if (intervalNS > 0.0) {
+                waitUntil(clock, threadStart, intendedNS);
+            }
+            unsigned char operation = operations[slot];
+            if ( (operation == DELETE) && (deleted == inserted) ) {
+                operation = INSERT;     // nothing of ours to delete
+            } else if ( (operation == INSERT) && (inserted - deleted == insertWindow) ) {
+                operation = DELETE;     // no room for more
+            }
+            unsigned int key = operation == INSERT ? insertedKey(inserted) :
+                               operation == DELETE ? insertedKey(deleted)  : keys[slot];
+            auto run = [this, operation, key] {
+                switch (operation) {
+                    case INSERT:
+                        algorithms->insertAlgorithm(key);
+                        break;
+                    case SELECT:
+                        algorithms->selectAlgorithm(key);
+                        break;
+                    case UPDATE:
+                        if (readModifyWrite) {
+                            algorithms->selectAlgorithm(key);
+                        }
+                        algorithms->updateAlgorithm(key);
+                        break;
+                    case DELETE:
+                        algorithms->deleteAlgorithm(key);
+                        break;
+                }
+            };
+            unsigned long long start = clock.start();
+            if (history == nullptr) {
+                run();
+            } else {
+                history->record(threadNumber, (OperationHistory::EOperation)operation, key, run);
+            }
+            unsigned long long finish = clock.stop();
+            latencies[operation].record((unsigned long long)clock.elapsedNS(start, finish));
+            if (intervalNS > 0.0) {
+                intendedLatencies[operation].record((unsigned long long)std::max(clock.elapsedNS(threadStart, finish) - intendedNS, 0.0));
+            }
+            inserted += operation == INSERT ? 1 : 0;
+            deleted  += operation == DELETE ? 1 : 0;
+        }
+        endUS = TimeMeasurements::getMonotonicRealTimeUS();
+    }
+
+    /** Sleeps -- if far from it -- then spins until 'intendedNS' after 'threadStart' */
+    static void waitUntil(const PrecisionClock& clock, unsigned long long threadStart, double intendedNS) {
+        constexpr double sleepThresholdNS = 200'000.0;     // sleeping overshoots by tens of microseconds
+        for (double aheadNS = intendedNS - clock.elapsedNS(threadStart, clock.start()); aheadNS > 0.0;
+                    aheadNS = intendedNS - clock.elapsedNS(threadStart, clock.start())) {
+            if (aheadNS > sleepThresholdNS) {
+                this_thread::sleep_for(chrono::nanoseconds((long long)(aheadNS - sleepThresholdNS/2.0)));
+            } else {
+                this_thread::yield();
+            }
+        }
+    }
+
+    /** Deletes, untimed, the elements this thread inserted and did not delete */
+    void cleanUp() {
+        while (deleted < inserted) {
+            algorithms->deleteAlgorithm(insertedKey(deleted++));
+        }
+    }
+};
+
+/** Checks 'workload' may run on 'threads' threads on the data set sizes 'ns', given the hooks accept 'inserts' elements.
+  * Returns how many elements each thread may insert -- past the largest size, up to 'inserts' -- and have present at once */
+static unsigned int mixedWorkloadInsertWindow(const AlgorithmComplexityAndReentrancyAnalysis::MixedWorkload& workload, const vector<unsigned int>& ns,
+                                              int threads, int inserts) {
+    array<double, 4> proportions = {workload.insertProportion, workload.selectProportion, workload.updateProportion, workload.deleteProportion};
+    if ( any_of(proportions.begin(), proportions.end(), [](double p) { return p < 0.0; }) || (accumulate(proportions.begin(), proportions.end(), 0.0) <= 0.0) ) {
+        THROW_EXCEPTION(std::invalid_argument, "Mixed workload '" + workload.name + "' proportions must be non negative, with at least one positive");
+    }
+    if ( (!is_sorted(ns.begin(), ns.end())) || (adjacent_find(ns.begin(), ns.end()) != ns.end()) ) {
+        THROW_EXCEPTION(std::invalid_argument, "Mixed workload data set sizes must be strictly ascending");
+    }
+    if ( (ns.front() == 0) && ((workload.selectProportion > 0.0) || (workload.updateProportion > 0.0)) ) {
+        THROW_EXCEPTION(std::invalid_argument, "Mixed workload '" + workload.name + "' selects & updates need preloaded elements -- data set sizes must be positive");
+    }
+    // workload inserts take the elements past the largest size, up to the constructor's number of inserts -- which the hooks accept
+    unsigned int insertWindow = ns.back() < (unsigned int)inserts ? ((unsigned int)inserts - ns.back()) / threads : 0;
+    if ( (insertWindow == 0) && ((workload.insertProportion > 0.0) || (workload.deleteProportion > 0.0)) ) {
+        THROW_EXCEPTION(std::invalid_argument, "Mixed workload '" + workload.name + "' inserts & deletes need room for " + to_string(threads) +
+                                               " elements or more past the largest data set size (" + to_string(ns.back()) + ") -- there are " +
+                                               to_string(inserts) + " insert elements");
+    }
+    return insertWindow;
+}
+
+/** Returns the operations table of 'workload' -- each slot drawn by the workload proportions */
+static vector<unsigned char> mixedWorkloadOperations(const AlgorithmComplexityAndReentrancyAnalysis::MixedWorkload& workload, unsigned long long seed) {
+    array<double, 4>           proportions = {workload.insertProportion, workload.selectProportion, workload.updateProportion, workload.deleteProportion};
+    vector<unsigned char>      operations(MixedWorkloadSplitRun::tableSize);
+    mt19937_64                 random(seed);
+    discrete_distribution<int> operationDistribution(proportions.begin(), proportions.end());
+    for (unsigned char& operation : operations) {
+        operation = (unsigned char)operationDistribution(random);
+    }
+    return operations;
+}
+
+#define OUTPUT_MESSAGE(s) outputMessages.append(s); if (verbose) cerr << s << flush
+tuple<string, vector<tuple<unsigned int, double, array<LatencyHistogram, 4>>>> AlgorithmComplexityAndReentrancyAnalysis::
+        analyseMixedWorkload(const MixedWorkload& workload, const vector<unsigned int>& ns, int threads, double durationS, bool verbose) {
+
+    static const array<string, 4> operationNames = {"Insert", "Select", "Update", "Delete"};
+
+    if ( (threads <= 0) || (durationS <= 0.0) || ns.empty() ) {
+        THROW_EXCEPTION(std::invalid_argument, "A mixed workload needs at least 1 thread, a positive duration and 1 data set size");
+    }
+    unsigned int insertWindow = mixedWorkloadInsertWindow(workload, ns, threads, inserts);
+
+    vector<tuple<unsigned int, double, array<LatencyHistogram, 4>>> results;
+    vector<unsigned long long> deltaTs;
+    vector<unsigned int>       rs;
+    vector<string>             historyReports;      // of each size -- if recording
+    unsigned long long         exceptionsCount = 0;
+    string                     firstExceptionReportMessage;
+    string                     outputMessages = "";
+
+    lastHistory.reset(historyEventsPerThread == 0 ? nullptr : new OperationHistory(threads, historyEventsPerThread, clock));
+
+    OUTPUT_MESSAGE(testName + " Mixed Workload Analysis -- " + workload.toString() + ", " + to_string(threads) + " threads for " + to_string(durationS) + "s on each size: ");
+
+    resetTablesOnPlacementCpus(EResetOccasion::FULL_RESET);
+
+    unsigned int preloaded = 0;
+    for (unsigned int n : ns) {
+
+        OUTPUT_MESSAGE("n=" + to_string(n) + " (Preload ");
+
+        // PRELOAD -- untimed; the remainder of the division among threads goes on this thread
+        unsigned int perThreadInserts = (n - preloaded) / threads;
+        vector<string> exceptions, exceptionReportMessages;
+        tie(ignore, ignore, exceptions, exceptionReportMessages) = runAlgorithmAnalysisPhase<InsertSplitRun>(this, threads, perThreadInserts, preloaded);
+        insertRange(preloaded + perThreadInserts*threads, n);
+        preloaded = n;
+
+        // operations & keys tables, computed before the workload is timed
+        vector<unsigned char> operations = mixedWorkloadOperations(workload, n);
+        vector<unsigned int>  keys = n == 0 ? vector<unsigned int>(MixedWorkloadSplitRun::tableSize, 0) : keyDistribution.sample(n, MixedWorkloadSplitRun::tableSize);
+
+        // MIXED WORKLOAD
+        OUTPUT_MESSAGE("Mix");
+        if (lastHistory) {
+            lastHistory->clear();
+        }
+        unsigned long long deadlineUS = TimeMeasurements::getMonotonicRealTimeUS() + (unsigned long long)(durationS * 1'000'000.0);
+        vector<unique_ptr<MixedWorkloadSplitRun>> splitRunInstances(threads);
+        for (int threadNumber=0; threadNumber<threads; threadNumber++) {
+            splitRunInstances[threadNumber] = unique_ptr<MixedWorkloadSplitRun>(new MixedWorkloadSplitRun(threadNumber, threads, this, operations, keys, workload.readModifyWrite,
+                                                                                                         ns.back(), insertWindow, deadlineUS));
+            splitRunInstances[threadNumber]->history = lastHistory.get();
+            SplitRun::add(*splitRunInstances[threadNumber]);
+        }
+        vector<string> mixExceptions, mixExceptionReportMessages;
+        tie(mixExceptions, mixExceptionReportMessages) = SplitRun::runAndWaitForAll();
+        exceptions.insert(exceptions.end(), mixExceptions.begin(), mixExceptions.end());
+        exceptionReportMessages.insert(exceptionReportMessages.end(), mixExceptionReportMessages.begin(), mixExceptionReportMessages.end());
+
+        // the preloaded elements start present; the inserted ones, absent -- checked before the clean up, which is not recorded
+        if (lastHistory) {
+            OUTPUT_MESSAGE(", Check");
+            historyReports.push_back(get<1>(lastHistory->check([n](unsigned int key) { return key < n; })));
+        }
+
+        // restores the data set to the preloaded elements
+        for (unique_ptr<MixedWorkloadSplitRun>& splitRunInstance : splitRunInstances) {
+            splitRunInstance->cleanUp();
+        }
+
+        array<LatencyHistogram, 4> latencies;
+        unsigned long long         startUS = ULLONG_MAX, endUS = 0, operationsCount = 0;
+        for (unique_ptr<MixedWorkloadSplitRun>& splitRunInstance : splitRunInstances) {
+            for (int operation=0; operation<4; operation++) {
+                latencies[operation].merge(splitRunInstance->latencies[operation]);
+                operationsCount += splitRunInstance->latencies[operation].getCount();
+            }
+            startUS = std::min(startUS, splitRunInstance->startUS);
+            endUS   = std::max(endUS,   splitRunInstance->endUS);
+        }
+        unsigned long long elapsedUS    = endUS > startUS ? endUS - startUS : 1;
+        double             opsPerSecond = ((double)operationsCount) * 1'000'000.0 / ((double)elapsedUS);
+        results.push_back({n, opsPerSecond, latencies});
+        deltaTs.push_back(elapsedUS);
+        rs.push_back((unsigned int)std::min(operationsCount, (unsigned long long)UINT_MAX));
+
+        exceptionsCount += exceptions.size();
+        if ( firstExceptionReportMessage.empty() && (!exceptionReportMessages.empty()) ) {
+            firstExceptionReportMessage = exceptionReportMessages.front();
+        }
+
+        OUTPUT_MESSAGE("); ");
+    }
+
+    OUTPUT_MESSAGE("done.\n");
+    OUTPUT_MESSAGE("Thread placement: " + threadPlacement.toString() + "\n");
+    OUTPUT_MESSAGE("Key distribution: " + keyDistribution.toString() + "\n");
+    OUTPUT_MESSAGE("Clock: " + clock.toString() + "\n");
+
+    double firstOpsPerSecond = get<1>(results.front());
+    for (size_t size=0; size<results.size(); size++) {
+        auto& [n, opsPerSecond, latencies] = results[size];
+        char throughput[128];
+        snprintf(throughput, sizeof(throughput), "n=%u: %.0f ops/s (%+.1f%% from n=%u)\n", n, opsPerSecond,
+                 firstOpsPerSecond > 0.0 ? (opsPerSecond / firstOpsPerSecond - 1.0) * 100.0 : 0.0, get<0>(results.front()));
+        OUTPUT_MESSAGE(string(throughput));
+        for (int operation=0; operation<4; operation++) {
+            if (latencies[operation].getCount() > 0) {
+                OUTPUT_MESSAGE("    " + operationNames[operation] + " latencies (ns): " + latencies[operation].toString() + "\n");
+            }
+        }
+        if (size < historyReports.size()) {
+            OUTPUT_MESSAGE("    " + historyReports[size]);
+        }
+    }
+
+    // how the mean operation time -- all threads together -- grows with the data set
+    if (ns.size() >= 2) {
+        string algorithmAnalisysReport;
+        tie(ignore, ignore, ignore, algorithmAnalisysReport) = computeAlgorithmAnalysisByRegression("Mixed operation", deltaTs, ns, ns, rs);
+        OUTPUT_MESSAGE(algorithmAnalisysReport + "\n");
+    }
+
+    if (exceptionsCount > 0) {
+        OUTPUT_MESSAGE(to_string(exceptionsCount) + " exceptions were thrown -- the first: " + firstExceptionReportMessage + "\n");
+    }
+
+    resetTablesOnPlacementCpus(EResetOccasion::FINAL_RESET);
+
+    return {outputMessages, results};
+}
+#undef OUTPUT_MESSAGE
+
+
+#define OUTPUT_MESSAGE(s) outputMessages.append(s); if (verbose) cerr << s << flush
+tuple<string, vector<tuple<double, double, LatencyHistogram, LatencyHistogram>>, double> AlgorithmComplexityAndReentrancyAnalysis::
+        analyseOpenLoop(const MixedWorkload& workload, unsigned int n, int threads, const vector<double>& ratesPerThread, double durationS, bool verbose) {
+
+    constexpr double saturatedThroughputFraction = 0.95;     // of the offered rate, under which the achieved throughput tells saturation
+
+    if ( (threads <= 0) || (durationS <= 0.0) || ratesPerThread.empty() ) {
+        THROW_EXCEPTION(std::invalid_argument, "An open loop analysis needs at least 1 thread, a positive duration and 1 rate");
+    }
+    if ( (!is_sorted(ratesPerThread.begin(), ratesPerThread.end())) || (ratesPerThread.front() <= 0.0) ) {
+        THROW_EXCEPTION(std::invalid_argument, "Open loop rates must be positive and ascending");
+    }
+    unsigned int insertWindow = mixedWorkloadInsertWindow(workload, {n}, threads, inserts);
+
+    vector<tuple<double, double, LatencyHistogram, LatencyHistogram>> results;
+    vector<unsigned long long> givenUpOperations;
+    unsigned long long         exceptionsCount = 0;
+    string                     firstExceptionReportMessage;
+    string                     outputMessages = "";
+
+    OUTPUT_MESSAGE(testName + " Open Loop Analysis -- " + workload.toString() + ", n=" + to_string(n) + ", " + to_string(threads) + " threads for " +
+                   to_string(durationS) + "s on each rate: ");
+
+    resetTablesOnPlacementCpus(EResetOccasion::FULL_RESET);
+
+    // PRELOAD -- untimed; the remainder of the division among threads goes on this thread
+    OUTPUT_MESSAGE("Preload; ");
+    unsigned int perThreadInserts = n / threads;
+    vector<string> exceptions, exceptionReportMessages;
+    tie(ignore, ignore, exceptions, exceptionReportMessages) = runAlgorithmAnalysisPhase<InsertSplitRun>(this, threads, perThreadInserts, 0);
+    insertRange(perThreadInserts*threads, n);
+    exceptionsCount += exceptions.size();
+    if (!exceptionReportMessages.empty()) {
+        firstExceptionReportMessage = exceptionReportMessages.front();
+    }
+
+    // operations & keys tables, computed before the workload is timed
+    vector<unsigned char> operations = mixedWorkloadOperations(workload, n);
+    vector<unsigned int>  keys       = n == 0 ? vector<unsigned int>(MixedWorkloadSplitRun::tableSize, 0) : keyDistribution.sample(n, MixedWorkloadSplitRun::tableSize);
+
+    for (double ratePerThread : ratesPerThread) {
+
+        OUTPUT_MESSAGE(to_string((unsigned long long)ratePerThread) + "/s ");
+
+        unsigned long long scheduledOperations = std::max((unsigned long long)(ratePerThread * durationS), 1ull);
+        unsigned long long deadlineUS          = TimeMeasurements::getMonotonicRealTimeUS() + (unsigned long long)(2.0 * durationS * 1'000'000.0);
+        vector<unique_ptr<MixedWorkloadSplitRun>> splitRunInstances(threads);
+        for (int threadNumber=0; threadNumber<threads; threadNumber++) {
+            splitRunInstances[threadNumber] = unique_ptr<MixedWorkloadSplitRun>(new MixedWorkloadSplitRun(threadNumber, threads, this, operations, keys, workload.readModifyWrite,
+                                                                                                         n, insertWindow, deadlineUS,
+                                                                                                         1'000'000'000.0 / ratePerThread, scheduledOperations));
+            SplitRun::add(*splitRunInstances[threadNumber]);
+        }
+        tie(exceptions, exceptionReportMessages) = SplitRun::runAndWaitForAll();
+        exceptionsCount += exceptions.size();
+        if ( firstExceptionReportMessage.empty() && (!exceptionReportMessages.empty()) ) {
+            firstExceptionReportMessage = exceptionReportMessages.front();
+        }
+
+        // restores the data set to the preloaded elements
+        for (unique_ptr<MixedWorkloadSplitRun>& splitRunInstance : splitRunInstances) {
+            splitRunInstance->cleanUp();
+        }
+
+        LatencyHistogram   latencies, serviceTimes;
+        unsigned long long startUS = ULLONG_MAX, endUS = 0;
+        for (unique_ptr<MixedWorkloadSplitRun>& splitRunInstance : splitRunInstances) {
+            for (int operation=0; operation<4; operation++) {
+                latencies.merge(splitRunInstance->intendedLatencies[operation]);
+                serviceTimes.merge(splitRunInstance->latencies[operation]);
+            }
+            startUS = std::min(startUS, splitRunInstance->startUS);
+            endUS   = std::max(endUS,   splitRunInstance->endUS);
+        }
+        double achievedOpsPerSecond = ((double)latencies.getCount()) * 1'000'000.0 / ((double)std::max(endUS - startUS, 1ull));
+        results.push_back({ratePerThread * threads, achievedOpsPerSecond, latencies, serviceTimes});
+        givenUpOperations.push_back(scheduledOperations*threads - latencies.getCount());
+    }
+
+    OUTPUT_MESSAGE("done.\n");
+    OUTPUT_MESSAGE("Thread placement: " + threadPlacement.toString() + "\n");
+    OUTPUT_MESSAGE("Key distribution: " + keyDistribution.toString() + "\n");
+    OUTPUT_MESSAGE("Clock: " + clock.toString() + "\n");
+
+    // latency versus throughput curve
+    double saturationOpsPerSecond = NAN;
+    double capacityOpsPerSecond   = 0.0;
+    size_t capacityRate           = 0;
+    char   line[256];
+    OUTPUT_MESSAGE("Open loop latencies -- from the intended starts -- & service times, for each offered rate:\n");
+    for (size_t rate=0; rate<results.size(); rate++) {
+        auto& [offeredOpsPerSecond, achievedOpsPerSecond, latencies, serviceTimes] = results[rate];
+        bool saturated = achievedOpsPerSecond < saturatedThroughputFraction * offeredOpsPerSecond;
+        if (saturated && isnan(saturationOpsPerSecond)) {
+            saturationOpsPerSecond = offeredOpsPerSecond;
+        }
+        if ( isnan(saturationOpsPerSecond) && (achievedOpsPerSecond >= capacityOpsPerSecond) ) {
+            capacityOpsPerSecond = achievedOpsPerSecond;
+            capacityRate         = rate;
+        }
+        snprintf(line, sizeof(line), "    offered %.0f ops/s: achieved %.0f ops/s (%.1f%%)", offeredOpsPerSecond, achievedOpsPerSecond,
+                 achievedOpsPerSecond * 100.0 / offeredOpsPerSecond);
+        OUTPUT_MESSAGE(string(line) + "; latencies (ns): " + latencies.toString() + "; service times (ns): " + serviceTimes.toString() +
+                       (givenUpOperations[rate] > 0 ? "; " + to_string(givenUpOperations[rate]) + " operations given up" : ""s) +
+                       (saturated ? " <-- saturated" : "") + "\n");
+    }
+    if (isnan(saturationOpsPerSecond)) {
+        snprintf(line, sizeof(line), "--> not saturated up to %.0f ops/s offered -- p99 latency %lluns", get<0>(results.back()),
+                 get<2>(results.back()).getPercentile(99.0));
+    } else {
+        snprintf(line, sizeof(line), "--> saturated at ~%.0f ops/s offered: the capacity is ~%.0f ops/s, with a p99 latency of %lluns", saturationOpsPerSecond,
+                 capacityOpsPerSecond, capacityOpsPerSecond > 0.0 ? get<2>(results[capacityRate]).getPercentile(99.0) : 0ull);
+    }
+    OUTPUT_MESSAGE(string(line) + "\n");
+
+    if (exceptionsCount > 0) {
+        OUTPUT_MESSAGE(to_string(exceptionsCount) + " exceptions were thrown -- the first: " + firstExceptionReportMessage + "\n");
+    }
+
+    resetTablesOnPlacementCpus(EResetOccasion::FINAL_RESET);
+
+    return {outputMessages, results, saturationOpsPerSecond};
+}
+#undef OUTPUT_MESSAGE
+
+
+/** Returns the least squares slope of 'ys' over 'xs' and its standard error -- NaNs for fewer than 3 points */
+static tuple<double, double> linearTrend(const vector<double>& xs, const vector<double>& ys) {
+    size_t n = xs.size();
+    if (n < 3) {
+        return {NAN, NAN};
+    }
+    double meanX = accumulate(xs.begin(), xs.end(), 0.0) / n;
+    double meanY = accumulate(ys.begin(), ys.end(), 0.0) / n;
+    double sxx = 0.0, sxy = 0.0;
+    for (size_t i=0; i<n; i++) {
+        sxx += (xs[i] - meanX) * (xs[i] - meanX);
+        sxy += (xs[i] - meanX) * (ys[i] - meanY);
+    }
+    if (sxx == 0.0) {
+        return {NAN, NAN};
+    }
+    double slope = sxy / sxx;
+    double sse   = 0.0;
+    for (size_t i=0; i<n; i++) {
+        double residual = ys[i] - meanY - slope*(xs[i] - meanX);
+        sse += residual * residual;
+    }
+    return {slope, sqrt(sse / (n - 2) / sxx)};
+}
+
+#define OUTPUT_MESSAGE(s) outputMessages.append(s); if (verbose) cerr << s << flush
+tuple<string, vector<AlgorithmComplexityAndReentrancyAnalysis::SoakSample>, double, double, double> AlgorithmComplexityAndReentrancyAnalysis::
+        analyseSoak(double durationS, int threads, unsigned int maximumSamples, bool verbose) {
+
+    if ( (threads <= 0) || (durationS <= 0.0) || (maximumSamples < 4) ) {
+        THROW_EXCEPTION(std::invalid_argument, "A soak analysis needs at least 1 thread, a positive duration and room for 4 samples or more");
+    }
+
+    unsigned int perThreadInserts = inserts / threads;
+    unsigned int inserted         = perThreadInserts * threads;
+    unsigned int perThreadSelects = std::min((unsigned int)selects, inserted) / threads;
+    unsigned int perThreadUpdates = std::min((unsigned int)updates, inserted) / threads;
+    unsigned long long cycleOperations = 2ull*inserted + (unsigned long long)(perThreadSelects + perThreadUpdates)*threads;
+    if (perThreadInserts == 0) {
+        THROW_EXCEPTION(std::invalid_argument, "A soak analysis on " + to_string(threads) + " threads needs at least as many insert elements -- there are " + to_string(inserts));
+    }
+
+    vector<SoakSample> ring(maximumSamples);     // preallocated: the latest 'maximumSamples' cycles
+    unsigned long long cycles          = 0;
+    long long          netAllocatedBytes = 0;
+    unsigned long long exceptionsCount = 0;
+    string             firstExceptionReportMessage;
+    string             outputMessages  = "";
+
+    // runs a phase, collecting its heap allocations & exceptions
+    auto runPhase = [&](auto phase) {
+        AllocationTracker::Values allocations;
+        auto [start, end, exceptions, exceptionReportMessages] = phase(&allocations);
+        netAllocatedBytes += allocations.getNetBytes();
+        exceptionsCount   += exceptions.size();
+        if ( firstExceptionReportMessage.empty() && (!exceptionReportMessages.empty()) ) {
+            firstExceptionReportMessage = exceptionReportMessages.front();
+        }
+    };
+
+    OUTPUT_MESSAGE(testName + " Soak Analysis -- " + to_string(threads) + " threads for " + to_string(durationS) + "s: ");
+
+    resetTablesOnPlacementCpus(EResetOccasion::FULL_RESET);
+
+    unsigned long long soakStartUS = TimeMeasurements::getMonotonicRealTimeUS();
+    unsigned long long soakEndUS   = soakStartUS + (unsigned long long)(durationS * 1'000'000.0);
+    for (unsigned long long cycleStartUS = soakStartUS; (cycles == 0) || (cycleStartUS < soakEndUS); cycles++) {
+        runPhase([&](AllocationTracker::Values* allocations) {
+            return runAlgorithmAnalysisPhase<InsertSplitRun>(this, threads, perThreadInserts, 0, nullptr, nullptr, allocations); });
+        if (perThreadSelects > 0) {
+            runPhase([&](AllocationTracker::Values* allocations) {
+                return runAlgorithmAnalysisPhase<SelectSplitRun>(this, threads, perThreadSelects, inserted - perThreadSelects*threads, nullptr, nullptr, allocations); });
+        }
+        if (perThreadUpdates > 0) {
+            runPhase([&](AllocationTracker::Values* allocations) {
+                return runAlgorithmAnalysisPhase<UpdateSplitRun>(this, threads, perThreadUpdates, inserted - perThreadUpdates*threads, nullptr, nullptr, allocations); });
+        }
+        runPhase([&](AllocationTracker::Values* allocations) {
+            return runAlgorithmAnalysisPhase<DeleteSplitRun>(this, threads, perThreadInserts, 0, nullptr, nullptr, allocations); });
+
+        unsigned long long cycleEndUS = TimeMeasurements::getMonotonicRealTimeUS();
+        ring[cycles % maximumSamples] = {cycles, ((double)(cycleEndUS - soakStartUS)) / 1'000'000.0, AllocationTracker::getResidentSetSizeBytes(),
+                                         netAllocatedBytes, ((double)cycleOperations) * 1'000'000.0 / ((double)std::max(cycleEndUS - cycleStartUS, 1ull))};
+        cycleStartUS = cycleEndUS;
+        OUTPUT_MESSAGE(".");
+    }
+
+    OUTPUT_MESSAGE(" done -- " + to_string(cycles) + " cycles.\n");
+    OUTPUT_MESSAGE("Thread placement: " + threadPlacement.toString() + "\n");
+    OUTPUT_MESSAGE("Key distribution: " + keyDistribution.toString() + "\n");
+
+    // the samples, oldest first
+    vector<SoakSample> samples;
+    for (unsigned long long cycle = cycles > maximumSamples ? cycles - maximumSamples : 0; cycle < cycles; cycle++) {
+        samples.push_back(ring[cycle % maximumSamples]);
+    }
+
+    // trends -- without the first cycle, warming up the allocator & caches
+    vector<double> cycleNumbers, elapsedHours, residentSetSizes, netAllocations, throughputs;
+    for (const SoakSample& sample : samples) {
+        if (sample.cycle > 0) {
+            cycleNumbers.push_back((double)sample.cycle);
+            elapsedHours.push_back(sample.elapsedS / 3600.0);
+            residentSetSizes.push_back((double)sample.residentSetSizeBytes);
+            netAllocations.push_back((double)sample.netAllocatedBytes);
+            throughputs.push_back(sample.opsPerSecond);
+        }
+    }
+    auto [leakBytesPerCycle,             leakError]       = linearTrend(cycleNumbers, netAllocations);
+    auto [residentSetSizeBytesPerCycle,  residentSetError] = linearTrend(cycleNumbers, residentSetSizes);
+    auto [opsPerSecondPerHour,           throughputError] = linearTrend(elapsedHours, throughputs);
+    double meanOpsPerSecond              = throughputs.empty() ? NAN : accumulate(throughputs.begin(), throughputs.end(), 0.0) / throughputs.size();
+    double throughputDriftPercentPerHour = opsPerSecondPerHour * 100.0 / meanOpsPerSecond;
+    double throughputDriftError          = throughputError * 100.0 / meanOpsPerSecond;
+
+    if (isnan(leakBytesPerCycle)) {
+        OUTPUT_MESSAGE("Soak trends: too few cycles -- at least 4 are needed\n");
+    } else {
+        // a trend is only told if it is beyond 2 standard errors
+        auto verdict = [](double slope, double error, const char* positive, const char* negative) {
+            return slope > 2.0*error ? positive : slope < -2.0*error ? negative : "stable";
+        };
+        char line[256];
+        OUTPUT_MESSAGE("Soak trends over cycles #" + to_string(samples.front().cycle == 0 ? 1 : samples.front().cycle) + " to #" + to_string(samples.back().cycle) + ":\n");
+        snprintf(line, sizeof(line), "    heap:       %+.1f bytes/cycle net allocated (+/- %.1f) --> %s\n", leakBytesPerCycle, leakError,
+                 verdict(leakBytesPerCycle, leakError, "LEAKING", "releasing"));
+        OUTPUT_MESSAGE(string(line));
+        snprintf(line, sizeof(line), "    RSS:        %+.1f bytes/cycle (+/- %.1f), now %llu bytes --> %s\n", residentSetSizeBytesPerCycle, residentSetError,
+                 samples.back().residentSetSizeBytes, verdict(residentSetSizeBytesPerCycle, residentSetError, "GROWING", "shrinking"));
+        OUTPUT_MESSAGE(string(line));
+        snprintf(line, sizeof(line), "    throughput: %.0f ops/s, drifting %+.2f%%/hour (+/- %.2f) --> %s\n", meanOpsPerSecond, throughputDriftPercentPerHour,
+                 throughputDriftError, verdict(throughputDriftPercentPerHour, throughputDriftError, "improving", "DEGRADING"));
+        OUTPUT_MESSAGE(string(line));
+    }
+
+    if (exceptionsCount > 0) {
+        OUTPUT_MESSAGE(to_string(exceptionsCount) + " exceptions were thrown -- the first: " + firstExceptionReportMessage + "\n");
+    }
+
+    resetTablesOnPlacementCpus(EResetOccasion::FINAL_RESET);
+
+    return {outputMessages, samples, leakBytesPerCycle, residentSetSizeBytesPerCycle, throughputDriftPercentPerHour};
+}
+#undef OUTPUT_MESSAGE
+
+/** Times rounds of selects -- or updates -- of all 'perThreadNumberOfOperations' elements of the data set, in the order of 'keys', after an
+  * untimed round bringing them into the caches */
+class CacheSweepSplitRun: public AlgorithmAnalysisSplitRun {
+public:
+    const bool         update;
+    const unsigned int rounds;
+    unsigned long long durationNS;
+
+    CacheSweepSplitRun(AlgorithmComplexityAndReentrancyAnalysis* algorithms, unsigned int n, const unsigned int* keys, bool update, unsigned int rounds)
+            : AlgorithmAnalysisSplitRun(0, n, algorithms, 0)
+            , update    (update)
+            , rounds    (rounds)
+            , durationNS(0) {
+        this->keys = keys;
+    }
+
+    void splitRun() override {
+        algorithms->getThreadPlacement().pinCurrentThread(threadNumber);
+        auto round = [this]() {
+            for (int i=0; i<perThreadNumberOfOperations; i++) {
+                unsigned int key = keys[i];
+                if (update) {
+                    algorithms->updateRange(key, key+1);
+                } else {
+                    algorithms->selectRange(key, key+1);
+                }
+            }
+        };
+        round();
+        const PrecisionClock& clock = algorithms->getClock();
+        unsigned long long    start = clock.start();
+        for (unsigned int r=0; r<rounds; r++) {
+            round();
+        }
+        unsigned long long    stop  = clock.stop();
+        durationNS = (unsigned long long)clock.elapsedNS(start, stop);
+    }
+};
+
+#define OUTPUT_MESSAGE(s) outputMessages.append(s); if (verbose) cerr << s << flush
+tuple<string, AlgorithmComplexityAndReentrancyAnalysis::CacheSweepResult> AlgorithmComplexityAndReentrancyAnalysis::
+        analyseCacheHierarchySweep(const CacheHierarchy& caches, int pointsPerRegime, double bytesPerElement, bool verbose) {
+
+    constexpr unsigned int minimumOperations = 65536;     // of each timed measurement
+    constexpr unsigned int probeElements     = 16384;     // inserted to measure the bytes per element
+    constexpr double       dramFactor        = 4.0;       // the DRAM regime goes up to this times the last level cache
+    constexpr double       kneeJump          = 1.15;      // a knee is a step of the time per operation of, at least, +15%...
+    constexpr double       kneeExponent      = 0.25;      // ... growing faster than n^0.25 over the sweep's median growth -- also, regimes
+                                                          // whose times vary less than 'kneeJump' are O(1), whatever shape fits their noise best
+
+    if (caches.isEmpty()) {
+        THROW_EXCEPTION(std::invalid_argument, "A cache hierarchy sweep needs the cache sizes -- none could be read on this machine: pass them to 'CacheHierarchy'");
+    }
+    if (pointsPerRegime < 2) {
+        THROW_EXCEPTION(std::invalid_argument, "A cache hierarchy sweep needs, at least, 2 points per regime to classify each of them");
+    }
+
+    CacheSweepResult result{};
+    string           outputMessages = "";
+    vector<string>   exceptions, exceptionReportMessages;
+    auto collectExceptions = [&](const vector<string>& phaseExceptions, const vector<string>& phaseExceptionReportMessages) {
+        exceptions.insert(exceptions.end(), phaseExceptions.begin(), phaseExceptions.end());
+        exceptionReportMessages.insert(exceptionReportMessages.end(), phaseExceptionReportMessages.begin(), phaseExceptionReportMessages.end());
+    };
+
+    OUTPUT_MESSAGE(testName + " Cache Hierarchy Sweep Analysis: " + caches.toString() + "; ");
+
+    // bytes per element
+    string bytesPerElementOrigin = "given";
+    if (bytesPerElement <= 0.0) {
+        unsigned int              probe = std::min((unsigned int)inserts, probeElements);
+        AllocationTracker::Values allocations;
+        resetTablesOnPlacementCpus(EResetOccasion::FULL_RESET);
+        auto [start, end, probeExceptions, probeExceptionReportMessages] = runAlgorithmAnalysisPhase<InsertSplitRun>(this, 1, probe, 0, nullptr, nullptr, &allocations);
+        collectExceptions(probeExceptions, probeExceptionReportMessages);
+        bytesPerElement       = ((double)allocations.getNetBytes()) / ((double)std::max(probe, 1u));
+        bytesPerElementOrigin = "measured";
+        if (bytesPerElement <= 0.0) {
+            // preallocated structures: no heap growth to measure
+            bytesPerElement       = caches.getLevels().front().lineBytes;
+            bytesPerElementOrigin = "assumed -- no heap growth measured";
+        }
+    }
+    result.bytesPerElement = bytesPerElement;
+    char line[256];
+    snprintf(line, sizeof(line), "%.1f bytes/element (%s); ", bytesPerElement, bytesPerElementOrigin.c_str());
+    OUTPUT_MESSAGE(string(line));
+
+    // regime boundaries, in elements, and their sizes
+    vector<string> regimeNames;
+    vector<double> regimeUpperNs;
+    for (const CacheHierarchy::Level& level : caches.getLevels()) {
+        regimeNames.push_back(CacheHierarchy::levelName(level.level));
+        regimeUpperNs.push_back(((double)level.sizeBytes) / bytesPerElement);
+    }
+    regimeNames.push_back("DRAM");
+    regimeUpperNs.push_back(regimeUpperNs.back() * dramFactor);
+    vector<int> sizeRegimes;        // of each size
+    for (size_t regime=0; regime<regimeUpperNs.size(); regime++) {
+        double lowerN = regime == 0 ? regimeUpperNs[0] / 8.0 : regimeUpperNs[regime-1];
+        for (int point = regime == 0 ? 0 : 1; point<=pointsPerRegime; point++) {
+            double n = lowerN * pow(regimeUpperNs[regime] / lowerN, ((double)point) / pointsPerRegime);
+            if ( (n < 2.0) || (n > (double)inserts) || ( (!result.ns.empty()) && ((unsigned int)n <= result.ns.back()) ) ) {
+                continue;
+            }
+            result.ns.push_back((unsigned int)n);
+            sizeRegimes.push_back((int)regime);
+        }
+    }
+    if (result.ns.size() < 2) {
+        THROW_EXCEPTION(std::invalid_argument, "A cache hierarchy sweep needs more insert elements: there are " + to_string(inserts) +
+                                               ", but the " + regimeNames.front() + " alone holds ~" + to_string((unsigned long long)regimeUpperNs.front()) + " elements");
+    }
+
+    OUTPUT_MESSAGE(to_string(result.ns.size()) + " sizes ( ");
+    resetTablesOnPlacementCpus(EResetOccasion::FULL_RESET);
+    KeyDistribution           uniformPermutation(KeyDistribution::EKeyDistribution::UNIFORM_RANDOM);
+    vector<unsigned long long> selectDeltaTs, updateDeltaTs;
+    vector<unsigned int>       rs;
+    unsigned int               previousN = 0;
+    for (unsigned int n : result.ns) {
+        auto [start, end, insertExceptions, insertExceptionReportMessages] = runAlgorithmAnalysisPhase<InsertSplitRun>(this, 1, n - previousN, previousN);
+        collectExceptions(insertExceptions, insertExceptionReportMessages);
+        previousN = n;
+
+        vector<unsigned int> keys   = keyDistribution.isSequential() ? uniformPermutation.permutation(0, n) : keyDistribution.sample(n, n);
+        unsigned int         rounds = std::max(1u, (minimumOperations + n - 1) / n);
+        for (bool update : {false, true}) {
+            CacheSweepSplitRun splitRun(this, n, keys.data(), update, rounds);
+            SplitRun::add(splitRun);
+            auto [phaseExceptions, phaseExceptionReportMessages] = SplitRun::runAndWaitForAll();
+            collectExceptions(phaseExceptions, phaseExceptionReportMessages);
+            (update ? updateDeltaTs : selectDeltaTs).push_back(splitRun.durationNS);
+            (update ? result.updateNS : result.selectNS).push_back(((double)splitRun.durationNS) / ((double)rounds*n));
+        }
+        rs.push_back(rounds*n);
+        OUTPUT_MESSAGE(to_string(n) + " ");
+    }
+    OUTPUT_MESSAGE(") done.\n");
+    OUTPUT_MESSAGE("Thread placement: " + threadPlacement.toString() + "\n");
+    OUTPUT_MESSAGE("Key distribution: " + (keyDistribution.isSequential() ? uniformPermutation.toString() + " -- replacing sequential, which prefetchers would hide" : keyDistribution.toString()) + "\n");
+    OUTPUT_MESSAGE("Clock: " + clock.toString() + "\n");
+
+    OUTPUT_MESSAGE("               n          bytes   regime     select ns/op   update ns/op\n");
+    for (size_t i=0; i<result.ns.size(); i++) {
+        snprintf(line, sizeof(line), "    %12u   %12s   %-6s   %12.2f   %12.2f\n", result.ns[i], CacheHierarchy::bytesToString((unsigned long long)(result.ns[i] * bytesPerElement)).c_str(),
+                 regimeNames[sizeRegimes[i]].c_str(), result.selectNS[i], result.updateNS[i]);
+        OUTPUT_MESSAGE(string(line));
+    }
+
+    // complexities: on all sizes, then on each regime alone
+    auto classify = [&rs](const string& operation, const vector<unsigned long long>& deltaTs, const vector<unsigned int>& ns, size_t first, size_t last) {
+        vector<unsigned long long> regimeDeltaTs(deltaTs.begin() + first, deltaTs.begin() + last);
+        vector<unsigned int>       regimeNs(ns.begin() + first, ns.begin() + last);
+        vector<unsigned int>       regimeRs(rs.begin() + first, rs.begin() + last);
+        double                     fastest = INFINITY, slowest = 0.0;
+        for (size_t k=first; k<last; k++) {
+            fastest = std::min(fastest, ((double)deltaTs[k]) / rs[k]);
+            slowest = std::max(slowest, ((double)deltaTs[k]) / rs[k]);
+        }
+        return slowest < fastest*kneeJump ? EAlgorithmComplexity::O1 : get<0>(computeAlgorithmAnalysisByRegression(operation, regimeDeltaTs, regimeNs, regimeNs, regimeRs));
+    };
+    result.selectComplexity = classify("Select", selectDeltaTs, result.ns, 0, result.ns.size());
+    result.updateComplexity = classify("Update", updateDeltaTs, result.ns, 0, result.ns.size());
+    for (size_t first=0; first<result.ns.size(); ) {
+        size_t last = first;
+        while ( (last < result.ns.size()) && (sizeRegimes[last] == sizeRegimes[first]) ) last++;
+        if (last - first >= 2) {
+            result.regimes.push_back({regimeNames[sizeRegimes[first]], result.ns[first], result.ns[last-1],
+                                      classify("Select", selectDeltaTs, result.ns, first, last), classify("Update", updateDeltaTs, result.ns, first, last)});
+        }
+        first = last;
+    }
+    for (bool update : {false, true}) {
+        EAlgorithmComplexity wholeRange = update ? result.updateComplexity : result.selectComplexity;
+        bool                 hierarchyEffect = !result.regimes.empty();
+        string               verdicts;
+        for (const CacheSweepResult::Regime& regime : result.regimes) {
+            EAlgorithmComplexity complexity = update ? regime.updateComplexity : regime.selectComplexity;
+            verdicts       += (verdicts.empty() ? "" : ", ") + regime.name + " " + EAlgorithmComplexityToString(complexity);
+            hierarchyEffect = hierarchyEffect && (complexity < wholeRange);
+        }
+        OUTPUT_MESSAGE(string(update ? "Update" : "Select") + ": all sizes --> " + EAlgorithmComplexityToString(wholeRange) + "; inside each regime: " + verdicts +
+                       (hierarchyEffect ? " -- the growth over all sizes is a memory hierarchy effect" : "") + "\n");
+    }
+
+    // knees: steps where the time per operation jumps above the sweep's median growth -- consecutive ones on the same cache boundary merged
+    unsigned int lastLevelKneeN = 0;
+    int          lastLevel      = (int)caches.getLevels().size() - 1;
+    for (bool update : {false, true}) {
+        const vector<double>& t = update ? result.updateNS : result.selectNS;
+        vector<double>        exponents;        // of each step
+        vector<int>           stepLevels;       // the cache boundary nearest, on a log scale, to each step -- if within a factor of 4; -1 if none
+        for (size_t k=1; k<t.size(); k++) {
+            exponents.push_back( (t[k-1] > 0.0) && (t[k] > 0.0) ? log(t[k] / t[k-1]) / log(((double)result.ns[k]) / result.ns[k-1]) : 0.0 );
+            int    nearestLevel    = -1;
+            double nearestDistance = log(4.0);
+            for (int level=0; level<=lastLevel; level++) {
+                double distance = fabs(log(regimeUpperNs[level] / sqrt(((double)result.ns[k-1]) * result.ns[k])));
+                if (distance <= nearestDistance) {
+                    nearestLevel    = level;
+                    nearestDistance = distance;
+                }
+            }
+            stepLevels.push_back(nearestLevel);
+        }
+        vector<double> sortedExponents(exponents);
+        sort(sortedExponents.begin(), sortedExponents.end());
+        double medianExponent = sortedExponents[sortedExponents.size() / 2];
+        auto isKneeStep = [&](size_t k) {       // from size k-1 to k
+            return (t[k] >= t[k-1]*kneeJump) && (exponents[k-1] >= medianExponent + kneeExponent);
+        };
+        for (size_t i=1; i<t.size(); ) {
+            if (!isKneeStep(i)) {
+                i++;
+                continue;
+            }
+            size_t last = i;
+            while ( (last+1 < t.size()) && isKneeStep(last+1) && (stepLevels[last] == stepLevels[i-1]) ) last++;
+            int          level   = stepLevels[i-1];
+            unsigned int beforeN = result.ns[i-1], afterN = result.ns[last];
+            result.kneeNs.push_back(beforeN);
+            if ( (level == lastLevel) && ( (lastLevelKneeN == 0) || (beforeN < lastLevelKneeN) ) ) {
+                lastLevelKneeN = beforeN;
+            }
+            snprintf(line, sizeof(line), "Knee: %s x%.2f from n=%u (%s) to n=%u (%s) -- %s\n", update ? "update" : "select", t[last] / t[i-1],
+                     beforeN, CacheHierarchy::bytesToString((unsigned long long)(beforeN * bytesPerElement)).c_str(),
+                     afterN,  CacheHierarchy::bytesToString((unsigned long long)(afterN  * bytesPerElement)).c_str(),
+                     level < 0 ? "on no cache boundary: algorithmic or TLB growth" :
+                                 ("the " + regimeNames[level] + " boundary, predicted at n=" + to_string((unsigned long long)regimeUpperNs[level])).c_str());
+            OUTPUT_MESSAGE(string(line));
+            i = last + 1;
+        }
+    }
+    sort(result.kneeNs.begin(), result.kneeNs.end());
+    result.kneeNs.erase(unique(result.kneeNs.begin(), result.kneeNs.end()), result.kneeNs.end());
+    if (result.kneeNs.empty()) {
+        OUTPUT_MESSAGE("Knees: none -- the time per operation grows smoothly over all sizes\n");
+    }
+
+    result.largestCacheResidentElements = lastLevelKneeN > 0 ? lastLevelKneeN : (unsigned int)std::min(regimeUpperNs[lastLevel], (double)UINT_MAX);
+    OUTPUT_MESSAGE("Largest cache resident shard: " + to_string(result.largestCacheResidentElements) + " elements (" +
+                   CacheHierarchy::bytesToString((unsigned long long)(result.largestCacheResidentElements * bytesPerElement)) + ") -- " +
+                   (lastLevelKneeN > 0 ? "measured" : "predicted from the " + regimeNames[lastLevel] + " size") + "\n");
+
+    if (!exceptions.empty()) {
+        OUTPUT_MESSAGE(to_string(exceptions.size()) + " exceptions were thrown -- the first: " + exceptionReportMessages.front() + "\n");
+    }
+
+    resetTablesOnPlacementCpus(EResetOccasion::FINAL_RESET);
+
+    return {outputMessages, result};
+}
+#undef OUTPUT_MESSAGE
+
+
+#define OUTPUT_MESSAGE(s) outputMessages.append(s); if (verbose) cerr << s << flush
+tuple<string, array<AlgorithmComplexityAndReentrancyAnalysis::ScalabilityResult, 4>> AlgorithmComplexityAndReentrancyAnalysis::
+        analyseScalability(bool performWarmUp, int maxThreads, bool verbose) {
+
+    static const array<string, 4> operationNames = {"Insert", "Select", "Update", "Delete"};
+
+    if (maxThreads == 0) {
+        maxThreads = std::max(2, (int)thread::hardware_concurrency());
+    }
+    if (maxThreads < 2) {
+        THROW_EXCEPTION(std::invalid_argument, "A scalability analysis needs at least 2 threads -- " + to_string(maxThreads) + " were given");
+    }
+
+    // thread counts: 1, 2, 4, ... and 'maxThreads'
+    vector<int> threadCounts;
+    for (int threads=1; threads<maxThreads; threads*=2) {
+        threadCounts.push_back(threads);
+    }
+    threadCounts.push_back(maxThreads);
+
+    array<ScalabilityResult, 4> results{};
+    array<vector<string>, 4>    exceptions, exceptionReportMessages;
+    string                      outputMessages = "";
+
+    // records the throughput of a phase of 'operations' operations run by 'threads' threads
+    auto collectPhase = [&results, &exceptions, &exceptionReportMessages](int operation, int threads, unsigned int operations,
+                                                                           const tuple<unsigned long long, unsigned long long, vector<string>, vector<string>>& phase) {
+        auto& [start, end, phaseExceptions, phaseExceptionReportMessages] = phase;
+        results[operation].threads.push_back(threads);
+        results[operation].opsPerSecond.push_back(((double)operations) * 1'000'000.0 / ((double)std::max(end - start, 1ull)));
+        exceptions[operation].insert(exceptions[operation].end(), phaseExceptions.begin(), phaseExceptions.end());
+        exceptionReportMessages[operation].insert(exceptionReportMessages[operation].end(), phaseExceptionReportMessages.begin(), phaseExceptionReportMessages.end());
+    };
+
+    OUTPUT_MESSAGE(testName + " Thread Scalability Analysis: ");
+
+    // WARMUP
+    if (performWarmUp) {
+        OUTPUT_MESSAGE(warmUp(maxThreads));
+    }
+
+    for (int threads : threadCounts) {
+
+        OUTPUT_MESSAGE("p=" + to_string(threads) + " ( ");
+
+        resetTablesOnPlacementCpus(EResetOccasion::FULL_RESET);
+
+        // INSERTS
+        unsigned int perThreadInserts = inserts / threads;
+        unsigned int inserted         = perThreadInserts * threads;
+        if (perThreadInserts > 0) {
+            OUTPUT_MESSAGE("Insert ");
+            collectPhase(0, threads, inserted, runAlgorithmAnalysisPhase<InsertSplitRun>(this, threads, perThreadInserts, 0));
+        }
+
+        // SELECTS & UPDATES -- on the last inserted elements
+        unsigned int perThreadSelects = std::min((unsigned int)selects, inserted) / threads;
+        if (perThreadSelects > 0) {
+            OUTPUT_MESSAGE("Select ");
+            collectPhase(1, threads, perThreadSelects*threads, runAlgorithmAnalysisPhase<SelectSplitRun>(this, threads, perThreadSelects, inserted - perThreadSelects*threads));
+        }
+        unsigned int perThreadUpdates = std::min((unsigned int)updates, inserted) / threads;
+        if (perThreadUpdates > 0) {
+            OUTPUT_MESSAGE("Update ");
+            collectPhase(2, threads, perThreadUpdates*threads, runAlgorithmAnalysisPhase<UpdateSplitRun>(this, threads, perThreadUpdates, inserted - perThreadUpdates*threads));
+        }
+
+        // DELETES
+        unsigned int perThreadDeletes = std::min((unsigned int)deletes, inserted) / threads;
+        if (perThreadDeletes > 0) {
+            OUTPUT_MESSAGE("Delete ");
+            collectPhase(3, threads, perThreadDeletes*threads, runAlgorithmAnalysisPhase<DeleteSplitRun>(this, threads, perThreadDeletes, inserted - perThreadDeletes*threads));
+        }
+
+        OUTPUT_MESSAGE("); ");
+    }
+
+    OUTPUT_MESSAGE("done.\n");
+    OUTPUT_MESSAGE("Thread placement: " + threadPlacement.toString() + "\n");
+    OUTPUT_MESSAGE("Key distribution: " + keyDistribution.toString() + "\n");
+
+    for (int operation=0; operation<4; operation++) {
+        // an operation with fewer elements than threads may lack the single thread measurement
+        if ( (results[operation].threads.size() < 2) || (results[operation].threads.front() != 1) ) {
+            results[operation] = ScalabilityResult{};
+            continue;
+        }
+        OUTPUT_MESSAGE(computeScalabilityByRegression(operationNames[operation], results[operation]) + "\n");
+        if (!exceptions[operation].empty()) {
+            OUTPUT_MESSAGE("    " + to_string(exceptions[operation].size()) + " exceptions were thrown -- the first: " + exceptionReportMessages[operation].front() + "\n");
+        }
+    }
+
+    resetTablesOnPlacementCpus(EResetOccasion::FINAL_RESET);
+
+    return {outputMessages, results};
+}
+#undef OUTPUT_MESSAGE
+
+
+
+/** Release / acquire published count of elements a reentrancy stage is done with, on which the next stage waits:
+  * spinning for a while and, then, sleeping on a futex until the count advances -- no polling sleeps */
+class Watermark {
+public:
+    static constexpr unsigned int spinIterations = 1024;
+
+    std::atomic<unsigned int> value;
+    std::atomic<int>          waiters;
+
+    Watermark() : value(0), waiters(0) {}
+
+    /** Publishes that all elements below 'newValue' are done, waking up any waiting stage -- never moves the watermark backwards */
+    inline void advance(unsigned int newValue) {
+        unsigned int current = value.load(std::memory_order_relaxed);
+        while ( (current < newValue) && (!value.compare_exchange_weak(current, newValue, std::memory_order_seq_cst)) );
+        if (waiters.load(std::memory_order_seq_cst) > 0) {
+            syscall(SYS_futex, &value, FUTEX_WAKE_PRIVATE, INT_MAX, nullptr, nullptr, 0);
+        }
+    }
+
+    inline bool isDone(unsigned int i) {
+        return value.load(std::memory_order_acquire) > i;
+    }
+
+    /** Waits until element 'i' is done or 'aborted' is set -- whoever sets it must, then, advance the watermark to wake up the waiters.
+      * Returns false if aborted */
+    inline bool waitFor(unsigned int i, const std::atomic<bool>& aborted) {
+        for (unsigned int spin=0; spin<spinIterations; spin++) {
+            if (aborted.load(std::memory_order_relaxed)) {
+                return false;
+            }
+            if (isDone(i)) {
+                return true;
+            }
+#if defined(__x86_64__) || defined(__i386__)
+            __builtin_ia32_pause();
+#endif
+        }
+        waiters.fetch_add(1, std::memory_order_seq_cst);
+        unsigned int current;
+        while ( ((current = value.load(std::memory_order_seq_cst)) <= i) && (!aborted.load(std::memory_order_seq_cst)) ) {
+            // the kernel only sleeps if 'value' is still 'current', so a concurrent 'advance' is never missed
+            syscall(SYS_futex, &value, FUTEX_WAIT_PRIVATE, current, nullptr, nullptr, 0);
+        }
+        waiters.fetch_sub(1, std::memory_order_seq_cst);
+        return !aborted.load(std::memory_order_seq_cst);
+    }
+};
+
+/** The elements of a reentrancy stage, claimed in chunks by the stage's threads from a shared cursor. As chunks may be
+  * finished out of order, the watermark is only advanced up to the first chunk not yet done */
+class ReentrancyStage {
+public:
+    static constexpr unsigned int chunkSize = 64;
+
+    const unsigned int                   numberOfElements;
+    const unsigned int                   numberOfChunks;
+    std::atomic<unsigned int>            nextChunk;           // the shared cursor
+    std::unique_ptr<std::atomic<bool>[]> chunkDone;
+    std::atomic<unsigned int>            doneChunks;          // all chunks below it are done
+    Watermark                            doneElements;
+    std::atomic<unsigned long long>      watermarkRetries;    // contention on advancing 'doneChunks'
+
+    explicit ReentrancyStage(unsigned int numberOfElements)
+            : numberOfElements(numberOfElements)
+            , numberOfChunks  ((numberOfElements + chunkSize - 1) / chunkSize)
+            , nextChunk       (0)
+            , chunkDone       (new std::atomic<bool>[numberOfChunks])
+            , doneChunks      (0)
+            , watermarkRetries(0) {
+        for (unsigned int chunk=0; chunk<numberOfChunks; chunk++) {
+            chunkDone[chunk].store(false, std::memory_order_relaxed);
+        }
+    }
+
+    /** Returns the claimed chunk's [begin, end[ elements -- begin == end when there is nothing left or the test was 'aborted' */
+    inline pair<unsigned int, unsigned int> claimChunk(const std::atomic<bool>& aborted) {
+        if (aborted.load(std::memory_order_relaxed)) {
+            return {numberOfElements, numberOfElements};
+        }
+        unsigned int chunk = nextChunk.fetch_add(1, std::memory_order_relaxed);
+        if (chunk >= numberOfChunks) {
+            return {numberOfElements, numberOfElements};
+        }
+        return {chunk*chunkSize, std::min((chunk+1)*chunkSize, numberOfElements)};
+    }
+
+    inline void markChunkDone(unsigned int begin) {
+        chunkDone[begin / chunkSize].store(true, std::memory_order_seq_cst);
+        unsigned int done = doneChunks.load(std::memory_order_seq_cst);
+        while ( (done < numberOfChunks) && chunkDone[done].load(std::memory_order_seq_cst) ) {
+            if (!doneChunks.compare_exchange_weak(done, done+1, std::memory_order_seq_cst)) {
+                watermarkRetries.fetch_add(1, std::memory_order_relaxed);
+            }
+            // either way, 'done' now holds the current value
+            done = doneChunks.load(std::memory_order_seq_cst);
+        }
+        doneElements.advance(std::min(done*chunkSize, numberOfElements));
+    }
+};
+
+class ReentrancySplitRunTest: public SplitRun {
+public:
+    static constexpr int                      numberOfOperations = 4;
+    static constexpr const char*              operationNames[numberOfOperations] = {"Insert", "Select", "Update", "Delete"};
+
+    AlgorithmComplexityAndReentrancyAnalysis* algorithms;
+    int                                       op;           // the next thread's ordinal: the first 'stageThreads[0]' threads insert, the next 'stageThreads[1]' select, ...
+    std::mutex                                opGuard;
+    unsigned int                              numberOfElements;
+    unsigned int                              verbosityFactor;
+    int                                       stageThreads  [numberOfOperations];
+    std::unique_ptr<ReentrancyStage>          stages        [numberOfOperations];  // the pipeline: each operation waits on the previous one's watermark
+    unsigned long long int                    timeusSpentInserting;
+    unsigned long long int                    timeusSpentTestingInsertsAndSelecting;
+    unsigned long long int                    timeusSpentUpdating;
+    unsigned long long int                    timeusSpentTestingUpdatesAndDeleting;
+    unsigned long long int                    stageStartUS  [numberOfOperations];    // of the first thread of the stage
+    unsigned long long int                    stageEndUS    [numberOfOperations];    // of the last  thread of the stage
+    unsigned long long int                    stageBlockedUS[numberOfOperations];    // time spent waiting for the previous stage, summed for all threads
+    unsigned long long int                    stageChunks   [numberOfOperations];
+    string&                                   testOutput;
+    std::mutex                                outputGuard;
+    vector<unsigned int>                      keys;         // the element of each index, for all stages -- empty if sequential
+    vector<LockStatistics::Values>            stageLocks    [numberOfOperations];    // instrumented lock counts, summed for all threads
+    OperationHistory*                         history;      // nullptr if not recording
+    std::atomic<bool>                         aborted;      // set when an algorithm throws: the pipeline is then drained, so no stage waits forever
+
+    ReentrancySplitRunTest(AlgorithmComplexityAndReentrancyAnalysis* algorithms, unsigned int numberOfElements, unsigned int verbosityFactor,
+                           int insertThreads, int selectThreads, int updateThreads, int deleteThreads, string& testOutput, OperationHistory* history)
+            : SplitRun(-1)
+            , algorithms(algorithms)
+            , op(0)
+            , numberOfElements(numberOfElements)
+            , verbosityFactor(verbosityFactor)
+            , stageThreads                         {insertThreads, selectThreads, updateThreads, deleteThreads}
+            , timeusSpentInserting                 (0ull)
+            , timeusSpentTestingInsertsAndSelecting(0ull)
+            , timeusSpentUpdating                  (0ull)
+            , timeusSpentTestingUpdatesAndDeleting (0ull)
+            , stageStartUS                         {~0ull, ~0ull, ~0ull, ~0ull}
+            , stageEndUS                           {}
+            , stageBlockedUS                       {}
+            , stageChunks                          {}
+    		, testOutput(testOutput)
+            , history(history)
+            , aborted(false) {
+        for (int operation=0; operation<numberOfOperations; operation++) {
+            stages[operation] = std::unique_ptr<ReentrancyStage>(new ReentrancyStage(numberOfElements));
+        }
+        // each stage waits for the previous one to be done with an index -- so, to be done with the same element, they all share the permutation
+        if (!algorithms->getKeyDistribution().isSequential()) {
+            keys = algorithms->getKeyDistribution().permutation(0, numberOfElements);
+        }
+    }
+
+    void output(const char* op) {
+        std::lock_guard<std::mutex> lock(outputGuard);
+    	testOutput.append(op);
+    	cerr << op << flush;
+    }
+
+    /** Stops the test: sets 'aborted' and advances the watermarks of all stages to the end, waking up their waiters. Not only the stages after
+      * the throwing one's: the chunk a throwing thread claimed is never marked done, and the threads of the previous stages stop as well, so
+      * any thread -- a sibling on the same stage included -- may be waiting on a watermark that would, otherwise, never move again */
+    void abortPipeline() {
+        aborted.store(true, std::memory_order_seq_cst);
+        for (int operation=0; operation<numberOfOperations; operation++) {
+            stages[operation]->doneElements.advance(numberOfElements);
+        }
+    }
+
+    /** Runs one thread of the 'operation' stage -- the 'thread'th of the test: claims chunks of elements and, for each element, waits for the
+      * previous stage to be done with it and runs 'algorithm' on it -- publishing the chunk for the next stage when it is done.
+      * If 'algorithm' throws, the test is aborted -- see {@link #abortPipeline} -- and the exception rethrown, after this thread's figures are accounted */
+    template <typename Algorithm>
+    void runStage(int operation, int thread, const char* verboseSymbol, unsigned long long int& timeusSpent, Algorithm algorithm) {
+        ReentrancyStage&       stage         = *stages[operation];
+        const PrecisionClock&  clock         = algorithms->getClock();
+        double                 spentNS       = 0.0;
+        unsigned long long int blockedUS     = 0;
+        unsigned long long int claimedChunks = 0;
+        vector<LockStatistics::Values> locksBefore = LockStatistics::threadSnapshot();
+        unsigned long long int threadStartUS = TimeMeasurements::getMonotonicRealTimeUS();
+        std::exception_ptr     exception;
+        try {
+            for (auto [begin, end] = stage.claimChunk(aborted); begin < end; tie(begin, end) = stage.claimChunk(aborted)) {
+                claimedChunks++;
+                for (unsigned int i=begin; i<end; i++) {
+                    if (aborted.load(std::memory_order_relaxed)) {
+                        break;
+                    }
+                    if ( (operation > 0) && (!stages[operation-1]->doneElements.isDone(i)) ) {
+                        unsigned long long waitStart = TimeMeasurements::getMonotonicRealTimeUS();
+                        bool               done      = stages[operation-1]->doneElements.waitFor(i, aborted);
+                        blockedUS += TimeMeasurements::getMonotonicRealTimeUS() - waitStart;
+                        if (!done) {
+                            break;
+                        }
+                    }
+                    if (verbosityFactor && (i % verbosityFactor == 0)) output(verboseSymbol);
+                    unsigned int           key    = keys.empty() ? i : keys[i];
+                    unsigned long long int start  = clock.start();
+                    if (history == nullptr) {
+                        algorithm(key);
+                    } else {
+                        history->record(thread, (OperationHistory::EOperation)operation, key, [&algorithm, key] { algorithm(key); });
+                    }
+                    unsigned long long int finish = clock.stop();
+                    spentNS += clock.elapsedNS(start, finish);
+                }
+                stage.markChunkDone(begin);
+            }
+        } catch (...) {
+            exception = std::current_exception();
+            abortPipeline();
+        }
+        unsigned long long int threadEndUS = TimeMeasurements::getMonotonicRealTimeUS();
+        vector<LockStatistics::Values> locksAfter = LockStatistics::threadSnapshot();
+        std::lock_guard<std::mutex> lock(opGuard);
+        LockStatistics::accumulateDifference(stageLocks[operation], locksAfter, locksBefore);
+        timeusSpent               += (unsigned long long int)(spentNS / 1000.0);
+        stageBlockedUS[operation] += blockedUS;
+        stageChunks[operation]    += claimedChunks;
+        stageStartUS[operation]    = std::min(stageStartUS[operation], threadStartUS);
+        stageEndUS[operation]      = std::max(stageEndUS[operation],   threadEndUS);
+        if (exception) {
+            std::rethrow_exception(exception);
+        }
+    }
+
+    void splitRun() override {
+        opGuard.lock();
+        int threadOrdinal = op++;
+        opGuard.unlock();
+        algorithms->getThreadPlacement().pinCurrentThread(threadOrdinal);
+        int thread    = threadOrdinal;
+        int operation = 0;
+        while ( (operation < numberOfOperations) && (threadOrdinal >= stageThreads[operation]) ) {
+            threadOrdinal -= stageThreads[operation++];
+        }
+        if (operation  == 0) {                    // INSERT
+            runStage(operation, thread, "I", timeusSpentInserting,                  [this](unsigned int i) { algorithms->insertAlgorithm(i); });
+        } else if (operation == 1) {             // SELECT
+            runStage(operation, thread, "S", timeusSpentTestingInsertsAndSelecting, [this](unsigned int i) { algorithms->selectAlgorithm(i); });
+        } else if (operation == 2) {             // UPDATE
+            runStage(operation, thread, "U", timeusSpentUpdating,                   [this](unsigned int i) { algorithms->updateAlgorithm(i); });
+        } else if (operation == 3) {             // DELETE
+            runStage(operation, thread, "D", timeusSpentTestingUpdatesAndDeleting,  [this](unsigned int i) { algorithms->deleteAlgorithm(i); });
+        } else {
+            THROW_EXCEPTION(std::runtime_error, "unknown operation #" + to_string(operation));
+        }
+    }
+
+    /** Returns, for each stage, its aggregate throughput -- on the stage's wall time -- and its contention figures: how long its threads
+      * were blocked on the previous stage, how many chunks they claimed, how many times they raced to advance the watermark and, for
+      * each instrumented lock the stage took, its acquisitions, waits & holds -- see {@link LockStatistics} */
+    string stagesReport() {
+        string report = "";
+        for (int operation=0; operation<numberOfOperations; operation++) {
+            unsigned long long int stageUS = stageEndUS[operation] - stageStartUS[operation];
+            report += "    "s + operationNames[operation] + " stage (threads: " + to_string(stageThreads[operation]) + "): " +
+                      to_string(stageUS == 0 ? 0ull : (1000000ull * numberOfElements) / stageUS) + " ops/s; " +
+                      to_string(stageBlockedUS[operation] / 1000llu) + "ms blocked" +
+                      (operation > 0 ? " on "s + operationNames[operation-1] + "s" : ""s) + "; " +
+                      to_string(stageChunks[operation]) + " chunks claimed; " +
+                      to_string(stages[operation]->watermarkRetries.load()) + " watermark retries\n";
+        }
+        for (int operation=0; operation<numberOfOperations; operation++) {
+            unsigned long long int stageUS = stageEndUS[operation] - stageStartUS[operation];
+            report += LockStatistics::report(operationNames[operation], stageLocks[operation], numberOfElements, stageThreads[operation] * stageUS * 1000ull);
+        }
+        return report;
+    }
+};
+
+#define OUTPUT_MESSAGE(s) outputMessages.append(s); if (verbose) cerr << s << flush
+string AlgorithmComplexityAndReentrancyAnalysis::
+		testReentrancy(unsigned int numberOfElements, bool verbose) {
+    return testReentrancy(numberOfElements, 1, 1, 1, 1, verbose);
+}
+
+string AlgorithmComplexityAndReentrancyAnalysis::
+		testReentrancy(unsigned int numberOfElements, int insertThreads, int selectThreads, int updateThreads, int deleteThreads, bool verbose) {
+
+    if ( (insertThreads < 1) || (selectThreads < 1) || (updateThreads < 1) || (deleteThreads < 1) ) {
+        THROW_EXCEPTION(std::invalid_argument, "Reentrancy tests need at least one thread for each operation");
+    }
+
+    string outputMessages = "";
+	OUTPUT_MESSAGE(testName + " Algorithm Reentrancy Tests");
+    resetTablesOnPlacementCpus(EResetOccasion::FULL_RESET);
+    OUTPUT_MESSAGE(": ");
+
+    int threads = insertThreads+selectThreads+updateThreads+deleteThreads;
+    lastHistory.reset(historyEventsPerThread == 0 ? nullptr : new OperationHistory(threads, historyEventsPerThread, clock));
+
+    ReentrancySplitRunTest reentrancyTest(this, numberOfElements, verbose ? numberOfElements/4 : 0,
+                                          insertThreads, selectThreads, updateThreads, deleteThreads, outputMessages, lastHistory.get());
+
+    // prepare the simultaneous tasks
+    for (int thread=0; thread<threads; thread++) {
+        SplitRun::add(reentrancyTest);
+    }
+
+    vector<string> exceptions, exceptionReportMessages;
+    tie(exceptions, exceptionReportMessages) = SplitRun::runAndWaitForAll();
+
+    OUTPUT_MESSAGE((reentrancyTest.aborted ? " ABORTED: " : " Done: "));
+    resetTablesOnPlacementCpus(EResetOccasion::FINAL_RESET);
+    OUTPUT_MESSAGE(to_string(reentrancyTest.timeusSpentInserting                  / 1000llu) + "ms inserting, " +
+           to_string(reentrancyTest.timeusSpentTestingInsertsAndSelecting / 1000llu) + "ms selecting & testing, " +
+		   to_string(reentrancyTest.timeusSpentUpdating                   / 1000llu) + "ms updating, " +
+		   to_string(reentrancyTest.timeusSpentTestingUpdatesAndDeleting  / 1000llu) + "ms testing & deleting.\n");
+    if (!exceptions.empty()) {
+        OUTPUT_MESSAGE("    " + to_string(exceptions.size()) + " exceptions were thrown, aborting the test -- the first: " + exceptionReportMessages.front() + "\n");
+    }
+    OUTPUT_MESSAGE(reentrancyTest.stagesReport());
+    if (lastHistory) {
+        // the tables start empty
+        OUTPUT_MESSAGE("    " + get<1>(lastHistory->check([](unsigned int) { return false; })));
+    }
+    OUTPUT_MESSAGE("    Thread placement: " + threadPlacement.toString() + "\n");
+    OUTPUT_MESSAGE("    Key distribution: " + keyDistribution.toString() + "\n");
+    OUTPUT_MESSAGE("    Clock: " + clock.toString() + "\n");
+
+    return outputMessages;
+}
+#undef OUTPUT_MESSAGE
+
+
+#define lPAD12(n) std::to_string(n) + ((n)>99999999999 ? "" : ((n)>9999999999 ? " " : ((n)>999999999 ? "  " : ((n)>99999999 ? "   " : ((n)>9999999 ? "    " : ((n)>999999 ? "     " : ((n)>99999 ? "      " : ((n)>9999 ? "       " : ((n)>999 ? "        " : ((n)>99 ? "         " : ((n)>9 ? "          " : "           ")))))))))))
+
+std::tuple<AlgorithmComplexityAndReentrancyAnalysis::EAlgorithmComplexity, string> AlgorithmComplexityAndReentrancyAnalysis::
+    	computeSelectOrUpdateAlgorithmAnalysis(
+    			const string&            operation,
+				const unsigned long int& start1,
+				const unsigned long int& end1,
+				const unsigned long int& start2,
+				const unsigned long int& end2,
+				const unsigned int       n1,
+				const unsigned int       n2,
+				const unsigned int       r) {
+
+    // the acceptable percent measurement error when computing complexity
+    double percentError = 0.10;
+
+    unsigned long int deltaT1 = end1 - start1;
+    unsigned long int deltaT2 = end2 - start2;
+    double t1 = ((double)deltaT1) / ((double)r);
+    double t2 = ((double)deltaT2) / ((double)r);
+
+    EAlgorithmComplexity complexity;
+
+    // sanity check
     if (((t1/t2) - 1.0) >= percentError) {
         complexity = EAlgorithmComplexity::BetterThanO1;
     } else
@@ -551,3 +2679,578 @@ tuple<AlgorithmComplexityAndReentrancyAnalysis::EAlgorithmComplexity, string> Al
     return {complexity, algorithmAnalysisReport};
 
 }
+
+
+std::tuple<AlgorithmComplexityAndReentrancyAnalysis::EAlgorithmComplexity, double, double, string> AlgorithmComplexityAndReentrancyAnalysis::
+        computeAlgorithmAnalysisByRegression(
+                const string&                     operation,
+                const vector<unsigned long long>& deltaTs,
+                const vector<unsigned int>&       firstNs,
+                const vector<unsigned int>&       lastNs,
+                const vector<unsigned int>&       rs) {
+
+    // the acceptable percent measurement error -- here, how much the log-log slope may go below 0 before being 'BetterThanO1'
+    double percentError = 0.10;
+
+    // how many points of f(n) are averaged to represent a pass on which the data set grows or shrinks
+    constexpr int averagingPoints = 16;
+
+    // the complexity models: t(1) = a + c * f(n)
+    static const tuple<EAlgorithmComplexity, double(*)(double)> models[] = {
+        {EAlgorithmComplexity::O1,     [](double)   { return 1.0;                }},
+        {EAlgorithmComplexity::Ologn,  [](double n) { return log2(n);            }},
+        {EAlgorithmComplexity::Olog2n, [](double n) { return log2(n)*log2(n);    }},
+        {EAlgorithmComplexity::Osqrtn, [](double n) { return sqrt(n);            }},
+        {EAlgorithmComplexity::On,     [](double n) { return n;                  }},
+        {EAlgorithmComplexity::Onlogn, [](double n) { return n*log2(n);          }},
+        {EAlgorithmComplexity::On2,    [](double n) { return n*n;                }},
+    };
+
+    size_t passes = deltaTs.size();
+    if ( (passes < 2) || (firstNs.size() != passes) || (lastNs.size() != passes) || (rs.size() != passes) ) {
+        THROW_EXCEPTION(std::invalid_argument, "Regression analysis for '" + operation + "' requires at least 2 passes and all measurement vectors to have the same size");
+    }
+
+    vector<double> t(passes);
+    double         meanT = 0.0;
+    for (size_t k=0; k<passes; k++) {
+        if (rs[k] == 0) {
+            THROW_EXCEPTION(std::invalid_argument, "Regression analysis for '" + operation + "': pass #" + to_string(k+1) + " performed no operations");
+        }
+        t[k]   = ((double)deltaTs[k]) / ((double)rs[k]);
+        meanT += t[k] / passes;
+    }
+
+    // least squares fit of each model, elected by the small sample corrected Akaike Information Criterion:
+    // AICc = K*ln(SSE/K) + 2p + 2p(p+1)/(K-p-1), for K passes and p fitted parameters
+    double sumTT = 0.0;
+    for (size_t k=0; k<passes; k++) {
+        sumTT += t[k] * t[k];
+    }
+    auto aicc = [passes, sumTT](double squaredError, int parameters) {
+        double K = (double)passes;
+        double sse = std::max(squaredError, sumTT * 1e-12);    // a perfect fit would yield -infinity
+        return K*log(sse/K) + 2.0*parameters + (K-parameters-1.0 > 0.0 ? 2.0*parameters*(parameters+1.0)/(K-parameters-1.0) : 0.0);
+    };
+    EAlgorithmComplexity complexity       = EAlgorithmComplexity::O1;
+    double               bestA            = 0.0;
+    double               bestC            = meanT;
+    double               bestSquaredError = -1.0;
+    double               bestAICc         = 0.0;
+    for (auto& [modelComplexity, f] : models) {
+        vector<double> x(passes);
+        double         meanX = 0.0;
+        for (size_t k=0; k<passes; k++) {
+            // the average f(n) while the data set went from firstNs[k] to lastNs[k] elements
+            if (firstNs[k] == lastNs[k]) {
+                x[k] = f(std::max((double)firstNs[k], 1.0));
+            } else {
+                x[k] = 0.0;
+                for (int p=0; p<averagingPoints; p++) {
+                    double n = firstNs[k] + (((double)lastNs[k]) - ((double)firstNs[k])) * (p+0.5) / averagingPoints;
+                    x[k] += f(std::max(n, 1.0)) / averagingPoints;
+                }
+            }
+            meanX += x[k] / passes;
+        }
+        // t = a + c*x -- only for growing models, with enough passes & a non negative fixed cost
+        double a = 0.0, c = 0.0;
+        int    parameters = 1;
+        double covariance = 0.0, variance = 0.0;
+        for (size_t k=0; k<passes; k++) {
+            covariance += (x[k] - meanX) * (t[k] - meanT);
+            variance   += (x[k] - meanX) * (x[k] - meanX);
+        }
+        if ( (modelComplexity != EAlgorithmComplexity::O1) && (passes >= 4) && (variance > 0.0) && (meanT - (covariance/variance)*meanX >= 0.0) ) {
+            c          = covariance / variance;
+            a          = meanT - c*meanX;
+            parameters = 2;
+        } else {
+            // t = c*x
+            double sumTX = 0.0, sumXX = 0.0;
+            for (size_t k=0; k<passes; k++) {
+                sumTX += t[k] * x[k];
+                sumXX += x[k] * x[k];
+            }
+            if (sumXX == 0.0) {
+                continue;
+            }
+            c = sumTX / sumXX;
+        }
+        if (c < 0.0) {
+            continue;   // decreasing times are not a growth model
+        }
+        double squaredError = 0.0;
+        for (size_t k=0; k<passes; k++) {
+            squaredError += (t[k] - a - c*x[k]) * (t[k] - a - c*x[k]);
+        }
+        double modelAICc = aicc(squaredError, parameters);
+        if ( (bestSquaredError < 0.0) || (modelAICc < bestAICc) ) {
+            complexity       = modelComplexity;
+            bestA            = a;
+            bestC            = c;
+            bestSquaredError = squaredError;
+            bestAICc         = modelAICc;
+        }
+    }
+
+    double goodnessOfFit = meanT > 0.0 ? std::max(0.0, 1.0 - (sqrt(bestSquaredError / passes) / meanT)) : 0.0;
+
+    // sanity check -- the log-log slope tells if the times decrease as n grows
+    double logLogSlope = 0.0;
+    if (all_of(t.begin(), t.end(), [](double tk) { return tk > 0.0; })) {
+        double meanLogN = 0.0, meanLogT = 0.0;
+        for (size_t k=0; k<passes; k++) {
+            meanLogN += log(std::max((firstNs[k] + lastNs[k]) / 2.0, 1.0)) / passes;
+            meanLogT += log(t[k]) / passes;
+        }
+        double covariance = 0.0, variance = 0.0;
+        for (size_t k=0; k<passes; k++) {
+            double dLogN = log(std::max((firstNs[k] + lastNs[k]) / 2.0, 1.0)) - meanLogN;
+            covariance  += dLogN * (log(t[k]) - meanLogT);
+            variance    += dLogN * dLogN;
+        }
+        logLogSlope = variance > 0.0 ? covariance / variance : 0.0;
+    }
+    if ( (complexity == EAlgorithmComplexity::O1) && (logLogSlope < -percentError) ) {
+        complexity = EAlgorithmComplexity::BetterThanO1;
+    }
+
+    string algorithmAnalysisReport = operation + " algorithm analysis (" + to_string(passes) + " sizes sweep):\n" +
+                                     "    (^t)            n              r               t(1)\n";
+    for (size_t k=0; k<passes; k++) {
+        unsigned long long n = std::max(firstNs[k], lastNs[k]);     // 'lPAD12' compares against 11 digit constants
+        unsigned long long r = rs[k];
+        algorithmAnalysisReport += to_string(k+1) + ":" + (k < 9 ? "  " : " ") + lPAD12(deltaTs[k]) + "\t" + lPAD12(n) + "\t" + lPAD12(r) + "\t" + std::to_string(t[k]) + "\n";
+    }
+    algorithmAnalysisReport += "--> " + EAlgorithmComplexityToString(complexity) +
+                               " -- c = " + std::to_string(bestC) + (bestA > 0.0 ? ", a = " + std::to_string(bestA) : ""s) + "; AICc: " + std::to_string(bestAICc) +
+                               "; goodness of fit: " + std::to_string(goodnessOfFit) + "; log-log slope: " + std::to_string(logLogSlope) + "\n";
+
+    return {complexity, goodnessOfFit, bestC, algorithmAnalysisReport};
+}
+
+
+std::tuple<AlgorithmComplexityAndReentrancyAnalysis::EAlgorithmComplexity, AlgorithmComplexityAndReentrancyAnalysis::EAlgorithmComplexity, string> AlgorithmComplexityAndReentrancyAnalysis::
+        computeAmortizedAlgorithmAnalysis(
+                const string&            operation,
+                const OperationTimeline& timeline) {
+
+    // spikes take more than 'spikeFactor' times the median; the ones above 'growingShare' of their octave's worst follow the worst case growth
+    constexpr double spikeFactor     = 10.0;
+    constexpr double growingShare    = 0.25;
+    // a period must predict, within +/- 'periodTolerance' of the interval, the next spike of, at least, 'periodAgreement' of them --
+    // judged on up to 'maximumPeriodCandidates' of the intervals between consecutive spikes
+    constexpr double periodTolerance         = 0.20;
+    constexpr double periodAgreement         = 0.60;
+    constexpr size_t maximumPeriodCandidates = 64;
+
+    // per octave sums & worst operations
+    vector<unsigned long long> octaveSumsNS, octaveWorstNS;
+    vector<unsigned int>       octaveFirstNs, octaveLastNs, octaveCounts, octaveWorstNs;
+    for (unsigned long long octave=amortizedAnalysisFirstN; octave<timeline.size(); octave*=2) {
+        unsigned int       lastN  = (unsigned int)std::min(octave*2, (unsigned long long)timeline.size()) - 1;
+        unsigned long long sumNS  = 0, worstNS = 0;
+        unsigned int       count  = 0, worstN  = (unsigned int)octave;
+        for (unsigned int n=(unsigned int)octave; n<=lastN; n++) {
+            if (timeline.isRecorded(n)) {
+                unsigned int ns = timeline.getDurationNS(n);
+                sumNS += ns;
+                count++;
+                if (ns > worstNS) {
+                    worstNS = ns;
+                    worstN  = n;
+                }
+            }
+        }
+        if (count > 0) {
+            octaveSumsNS.push_back(sumNS);
+            octaveWorstNS.push_back(worstNS);
+            octaveFirstNs.push_back((unsigned int)octave);
+            octaveLastNs.push_back(lastN);
+            octaveCounts.push_back(count);
+            octaveWorstNs.push_back(worstN);
+        }
+    }
+    if (octaveSumsNS.size() < 3) {
+        THROW_EXCEPTION(std::invalid_argument, "Amortized analysis for '" + operation + "' requires operations recorded on at least 3 octaves of n, starting at n=" +
+                                               std::to_string(amortizedAnalysisFirstN) + " -- the timeline has " + std::to_string(timeline.size()) + " slots");
+    }
+
+    // an octave's worst more than twice both neighbours' is an isolated hiccup -- a preemption, for instance -- and is capped: as the
+    // reference for its octave's spikes and on its octave's mean -- and left out of the worst case fit
+    size_t                     octaves = octaveSumsNS.size();
+    vector<unsigned long long> referenceWorstNS(octaveWorstNS);
+    vector<unsigned long long> fittedWorstNS;
+    vector<unsigned int>       fittedWorstNs, fittedOnes;
+    for (size_t k=0; k<octaves; k++) {
+        if ( (k > 0) && (k < octaves-1) && (octaveWorstNS[k] > 2*std::max(octaveWorstNS[k-1], octaveWorstNS[k+1])) ) {
+            referenceWorstNS[k] = 2*std::max(octaveWorstNS[k-1], octaveWorstNS[k+1]);
+            octaveSumsNS[k]    -= octaveWorstNS[k] - referenceWorstNS[k];
+            continue;
+        }
+        fittedWorstNS.push_back(octaveWorstNS[k]);
+        fittedWorstNs.push_back(octaveWorstNs[k]);
+        fittedOnes.push_back(1);
+    }
+
+    EAlgorithmComplexity amortizedComplexity, worstCaseComplexity;
+    string               amortizedReport, worstCaseReport;
+    tie(amortizedComplexity, ignore, ignore, amortizedReport) = computeAlgorithmAnalysisByRegression(operation + " amortized (ns)",  octaveSumsNS,  octaveFirstNs, octaveLastNs,  octaveCounts);
+    tie(worstCaseComplexity, ignore, ignore, worstCaseReport) = computeAlgorithmAnalysisByRegression(operation + " worst case (ns)", fittedWorstNS, fittedWorstNs, fittedWorstNs, fittedOnes);
+
+    // spikes & the ones growing with the worst case -- the period is only judged on the upper half of the octaves, where the
+    // algorithm's spikes stand out of the measurement noise
+    unsigned int periodFirstN = octaveFirstNs[octaves/2];
+    vector<OperationTimeline::Spike> spikes = timeline.findSpikes(spikeFactor);
+    unsigned long long totalNS = accumulate(octaveSumsNS.begin(), octaveSumsNS.end(), 0ull);
+    unsigned long long spikesNS = 0;
+    unsigned int       analysedSpikes = 0;
+    vector<double>     growingSpikeNs;
+    for (const OperationTimeline::Spike& spike : spikes) {
+        if (spike.n < amortizedAnalysisFirstN) {
+            continue;
+        }
+        spikesNS += spike.durationNS;
+        analysedSpikes++;
+        size_t octave = (upper_bound(octaveFirstNs.begin(), octaveFirstNs.end(), spike.n) - octaveFirstNs.begin()) - 1;
+        if ( (spike.n >= periodFirstN) && (spike.durationNS >= growingShare * referenceWorstNS[octave]) ) {
+            growingSpikeNs.push_back((double)spike.n);
+        }
+    }
+
+    // period: each candidate -- geometric, n' = r*n, or arithmetic, n' = n + g, taken from the intervals between consecutive spikes --
+    // is scored by how many spikes have a successor where it predicts, so a few noise spikes amid the periodic ones do no harm
+    auto score = [&growingSpikeNs, periodTolerance](const function<double(double)>& successor) {
+        size_t explained = 0;
+        for (size_t i=0; i+1<growingSpikeNs.size(); i++) {
+            double expected  = successor(growingSpikeNs[i]);
+            double tolerance = periodTolerance * (expected - growingSpikeNs[i]);
+            auto   candidate = lower_bound(growingSpikeNs.begin()+i+1, growingSpikeNs.end(), expected - tolerance);
+            if ( (candidate != growingSpikeNs.end()) && (*candidate <= expected + tolerance) ) {
+                explained++;
+            }
+        }
+        return explained;
+    };
+    string lowerCaseOperation = operation;
+    transform(lowerCaseOperation.begin(), lowerCaseOperation.end(), lowerCaseOperation.begin(), [](unsigned char c) { return tolower(c); });
+    string period;
+    if (growingSpikeNs.size() >= 3) {
+        double bestRatio = 0.0, bestGap = 0.0;
+        size_t bestRatioScore = 0, bestGapScore = 0;
+        size_t step = std::max((size_t)1, growingSpikeNs.size() / maximumPeriodCandidates);
+        for (size_t i=1; i<growingSpikeNs.size(); i+=step) {
+            double ratio = growingSpikeNs[i] / growingSpikeNs[i-1];
+            double gap   = growingSpikeNs[i] - growingSpikeNs[i-1];
+            size_t ratioScore = ratio >= 1.0 + periodTolerance ? score([ratio](double n) { return n * ratio; }) : 0;
+            size_t gapScore   = score([gap](double n) { return n + gap; });
+            if (ratioScore > bestRatioScore) {
+                bestRatio      = ratio;
+                bestRatioScore = ratioScore;
+            }
+            if (gapScore > bestGapScore) {
+                bestGap      = gap;
+                bestGapScore = gapScore;
+            }
+        }
+        size_t intervals = growingSpikeNs.size() - 1;
+        char   base[16];
+        snprintf(base, sizeof(base), "%.2f", bestRatio);
+        if ( (bestRatioScore >= bestGapScore) && (bestRatioScore >= periodAgreement * intervals) ) {
+            period = " every ~" + (fabs(bestRatio - 2.0) <= periodTolerance ? "2"s : string(base)) + "^k " + lowerCaseOperation + "s";
+        } else if (bestGapScore >= periodAgreement * intervals) {
+            period = " every ~" + std::to_string((unsigned long long)round(bestGap)) + " " + lowerCaseOperation + "s";
+        } else {
+            period = " on irregular spikes";
+        }
+    }
+
+    string report = operation + " amortized vs worst case analysis (timeline of " + std::to_string(timeline.getRecordedCount()) + " operations, median " +
+                    std::to_string(timeline.getMedianNS()) + "ns):\n" +
+                    amortizedReport + worstCaseReport +
+                    "spikes (> " + std::to_string((int)spikeFactor) + "x the median, from n=" + std::to_string(amortizedAnalysisFirstN) + "): " + std::to_string(analysedSpikes) +
+                    ", taking " + std::to_string(totalNS == 0 ? 0.0 : 100.0 * spikesNS / totalNS) + "% of the time; " +
+                    std::to_string(growingSpikeNs.size()) + " of them, from n=" + std::to_string(periodFirstN) + ", comparable to their octave's worst";
+    for (size_t i=0; i<growingSpikeNs.size() && i<8; i++) {
+        report += (i == 0 ? ", at n = " : ", ") + std::to_string((unsigned long long)growingSpikeNs[i]);
+    }
+    report += (growingSpikeNs.size() > 8 ? ", ...\n" : "\n");
+    report += "--> amortized " + EAlgorithmComplexityToString(amortizedComplexity) + ", worst case " + EAlgorithmComplexityToString(worstCaseComplexity) + period + "\n";
+
+    return {amortizedComplexity, worstCaseComplexity, report};
+}
+
+
+string AlgorithmComplexityAndReentrancyAnalysis::
+        computeScalabilityByRegression(const string& operation, ScalabilityResult& result) {
+
+    size_t measurements = result.threads.size();
+    auto   single       = find(result.threads.begin(), result.threads.end(), 1);
+    if ( (measurements < 2) || (result.opsPerSecond.size() != measurements) || (single == result.threads.end()) ) {
+        THROW_EXCEPTION(std::invalid_argument, operation + " scalability analysis needs the throughputs of 2 or more thread counts, including 1 -- " +
+                                               to_string(measurements) + " thread counts and " + to_string(result.opsPerSecond.size()) + " throughputs were given");
+    }
+    double singleOpsPerSecond = result.opsPerSecond[single - result.threads.begin()];
+
+    // linearized: y = p/S(p) - 1 = sigma*x1 + kappa*x2, with x1 = p-1 and x2 = p*(p-1)
+    double sx1x1 = 0.0, sx1x2 = 0.0, sx2x2 = 0.0, sx1y = 0.0, sx2y = 0.0;
+    for (size_t k=0; k<measurements; k++) {
+        double p  = (double)result.threads[k];
+        double s  = result.opsPerSecond[k] / singleOpsPerSecond;
+        double y  = p/s - 1.0;
+        double x1 = p - 1.0;
+        double x2 = p * (p - 1.0);
+        sx1x1 += x1*x1;  sx1x2 += x1*x2;  sx2x2 += x2*x2;
+        sx1y  += x1*y;   sx2y  += x2*y;
+    }
+    // Amdahl -- kappa = 0
+    result.serialFraction = std::clamp(sx1x1 > 0.0 ? sx1y / sx1x1 : 0.0, 0.0, 1.0);
+    // USL -- falling back to a single coefficient if the other comes out negative or can not be told apart (only 1 & 2 threads)
+    double determinant = sx1x1*sx2x2 - sx1x2*sx1x2;
+    double sigma = 0.0, kappa = 0.0;
+    if (determinant > 1e-9 * sx1x1*sx2x2) {
+        sigma = (sx1y*sx2x2 - sx2y*sx1x2) / determinant;
+        kappa = (sx2y*sx1x1 - sx1y*sx1x2) / determinant;
+    }
+    if ( (determinant <= 1e-9 * sx1x1*sx2x2) || (kappa < 0.0) ) {
+        sigma = sx1x1 > 0.0 ? sx1y / sx1x1 : 0.0;
+        kappa = 0.0;
+    } else if (sigma < 0.0) {
+        sigma = 0.0;
+        kappa = sx2x2 > 0.0 ? std::max(0.0, sx2y / sx2x2) : 0.0;
+    }
+    sigma = std::max(0.0, sigma);
+    result.contention  = sigma;
+    result.coherency   = kappa;
+    result.peakThreads = kappa > 0.0   ? std::max(1.0, sqrt((1.0 - std::min(sigma, 1.0)) / kappa)) :
+                         sigma >= 1.0  ? 1.0 :          // more threads only slow it down
+                                         INFINITY;
+
+    auto uslSpeedup = [sigma, kappa](double p) {
+        return p / (1.0 + sigma*(p - 1.0) + kappa*p*(p - 1.0));
+    };
+
+    char   line[256];
+    string report = operation + " thread scalability analysis:\n"
+                    "    threads     ops/s           speedup     efficiency  USL speedup\n";
+    double sumSquaredErrors = 0.0, sumSpeedups = 0.0;
+    for (size_t k=0; k<measurements; k++) {
+        double p = (double)result.threads[k];
+        double s = result.opsPerSecond[k] / singleOpsPerSecond;
+        sumSquaredErrors += (s - uslSpeedup(p)) * (s - uslSpeedup(p));
+        sumSpeedups      += s;
+        snprintf(line, sizeof(line), "    %-12d%-16.0f%-12.2f%-12s%.2f\n", result.threads[k], result.opsPerSecond[k], s,
+                 (to_string((int)round(s / p * 100.0)) + "%").c_str(), uslSpeedup(p));
+        report += line;
+    }
+    result.goodnessOfFit = 1.0 - sqrt(sumSquaredErrors / measurements) / (sumSpeedups / measurements);
+
+    int measuredThreads = *max_element(result.threads.begin(), result.threads.end());
+    snprintf(line, sizeof(line), "--> Amdahl s=%.4f; USL sigma=%.4f, kappa=%.6f: ", result.serialFraction, sigma, kappa);
+    report += line;
+    if (isinf(result.peakThreads)) {
+        if (sigma > 0.0) {
+            snprintf(line, sizeof(line), "no peak -- the speedup approaches 1/sigma = %.1f", 1.0 / sigma);
+        } else {
+            snprintf(line, sizeof(line), "linear scaling -- no contention measured");
+        }
+    } else {
+        snprintf(line, sizeof(line), "peak at ~%.0f threads (speedup %.2f)%s", result.peakThreads, uslSpeedup(round(result.peakThreads)),
+                 result.peakThreads > measuredThreads ? " -- extrapolated beyond the measured threads" : "");
+    }
+    report += line;
+    snprintf(line, sizeof(line), "; goodness of fit: %f", result.goodnessOfFit);
+    report += line;
+    return report;
+}
+
+
+string AlgorithmComplexityAndReentrancyAnalysis::
+        latencyHistogramsReport(const string& operation, const vector<LatencyHistogram>& histograms, const vector<unsigned int>& ns) {
+
+    string report = operation + " latencies (ns):\n" +
+                    "    n               p50            p99            p99.9          max\n";
+    for (size_t k=0; k<histograms.size(); k++) {
+        unsigned long long p50  = histograms[k].getPercentile(50.0);
+        unsigned long long p99  = histograms[k].getPercentile(99.0);
+        unsigned long long p999 = histograms[k].getPercentile(99.9);
+        unsigned long long max  = histograms[k].getMax();
+        unsigned long long n    = ns[k];     // 'lPAD12' compares against 11 digit constants
+        report += to_string(k+1) + ":" + (k < 9 ? "  " : " ") + lPAD12(n) + "\t" + lPAD12(p50) + "\t" + lPAD12(p99) + "\t" + lPAD12(p999) + "\t" + lPAD12(max) + "\n";
+    }
+    return report;
+}
+
+
+string AlgorithmComplexityAndReentrancyAnalysis::
+        performanceCountersReport(const string& operation, const vector<PerformanceCounters::Values>& perPassCounters, const vector<unsigned int>& rs,
+                                  const function<EAlgorithmComplexity(const string& counterName, const vector<unsigned long long>& perPassCounts)>& classify) {
+
+    string report = operation + " performance counters (per operation):\n    counter         ";
+    for (size_t k=0; k<perPassCounters.size(); k++) {
+        report += "\t" + lPAD12(k+1);
+    }
+    report += "\tcomplexity\n";
+    for (int counter=0; counter<PerformanceCounters::numberOfCounters; counter++) {
+        string counterName = PerformanceCounters::ECounterToString((PerformanceCounters::ECounter)counter);
+        report += "    " + counterName + string(16 - std::min((size_t)16, counterName.size()), ' ');
+        bool available = all_of(perPassCounters.begin(), perPassCounters.end(), [counter](const PerformanceCounters::Values& values) { return values.available[counter]; });
+        if (!available) {
+            report += "\tunavailable\n";
+            continue;
+        }
+        vector<unsigned long long> counts;
+        for (size_t k=0; k<perPassCounters.size(); k++) {
+            counts.push_back(perPassCounters[k].counts[counter]);
+            report += "\t" + std::to_string(((double)perPassCounters[k].counts[counter]) / ((double)std::max(rs[k], 1u)));
+        }
+        report += "\t" + EAlgorithmComplexityToString(classify(operation + " " + counterName, counts)) + "\n";
+    }
+    return report;
+}
+
+
+string AlgorithmComplexityAndReentrancyAnalysis::
+        allocationsReport(const vector<AllocationTracker::Values>& perPassAllocations, const vector<long long>& residentSetSizeDeltas, const vector<unsigned int>& ns) {
+
+    string report = "Insert space usage (per element):\n"
+                    "    allocations     deallocations   bytes           net bytes       RSS bytes\n";
+    for (size_t k=0; k<perPassAllocations.size(); k++) {
+        double n = (double)std::max(ns[k], 1u);
+        report += std::to_string(k+1) + ":  " + std::to_string(((double)perPassAllocations[k].allocations)    / n) +
+                                        "\t" + std::to_string(((double)perPassAllocations[k].deallocations)  / n) +
+                                        "\t" + std::to_string(((double)perPassAllocations[k].allocatedBytes) / n) +
+                                        "\t" + std::to_string(((double)perPassAllocations[k].getNetBytes())  / n) +
+                                        "\t" + std::to_string(((double)residentSetSizeDeltas[k])            / n) + "\n";
+    }
+    return report;
+}
+
+
+AlgorithmComplexityAndReentrancyAnalysis::ComplexityAnalysisResult AlgorithmComplexityAndReentrancyAnalysis::
+        newComplexityAnalysisResult(const string& method) const {
+    char hostName[256] = "";
+    gethostname(hostName, sizeof(hostName)-1);
+    ComplexityAnalysisResult result;
+    result.testName        = testName;
+    result.method          = method;
+    result.hostName        = hostName;
+#ifdef __VERSION__
+    result.compiler        = __VERSION__;
+#endif
+    result.onlineCpus      = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    result.threadPlacement = threadPlacement.toString();
+    result.keyDistribution = keyDistribution.toString();
+    result.unixTimeS       = (unsigned long long)time(nullptr);
+    return result;
+}
+
+
+/** Streams 's' as a JSON string literal */
+static void writeJSONString(ostream& out, const string& s) {
+    out << '"';
+    for (char c : s) {
+        switch (c) {
+            case '"':  out << "\\\""; break;
+            case '\\': out << "\\\\"; break;
+            case '\n': out << "\\n";  break;
+            case '\r': out << "\\r";  break;
+            case '\t': out << "\\t";  break;
+            default:
+                if ((unsigned char)c < 0x20) {
+                    const char* hex = "0123456789abcdef";
+                    out << "\\u00" << hex[(c >> 4) & 0xF] << hex[c & 0xF];
+                } else {
+                    out << c;
+                }
+        }
+    }
+    out << '"';
+}
+
+/** Streams 's' as a CSV field, quoted & with its quotes doubled */
+static void writeCSVString(ostream& out, const string& s) {
+    out << '"';
+    for (char c : s) {
+        if (c == '"') out << '"';
+        out << c;
+    }
+    out << '"';
+}
+
+/** Streams 'value' -- or JSON's 'null' / CSV's empty field, if it is not a number */
+static void writeNumber(ostream& out, double value, const char* notANumber) {
+    if (std::isfinite(value)) {
+        out << value;
+    } else {
+        out << notANumber;
+    }
+}
+
+void AlgorithmComplexityAndReentrancyAnalysis::ComplexityAnalysisResult::writeJSON(ostream& out) const {
+    out << "{\"testName\":";                 writeJSONString(out, testName);
+    out << ",\"method\":";                   writeJSONString(out, method);
+    out << ",\"environment\":{\"hostName\":"; writeJSONString(out, hostName);
+    out << ",\"compiler\":";                 writeJSONString(out, compiler);
+    out << ",\"onlineCpus\":" << onlineCpus;
+    out << ",\"threadPlacement\":";          writeJSONString(out, threadPlacement);
+    out << ",\"keyDistribution\":";          writeJSONString(out, keyDistribution);
+    out << ",\"unixTimeS\":" << unixTimeS << "},\"operations\":[";
+    bool firstOperation = true;
+    for (const Operation& operation : operations) {
+        if (operation.threads <= 0) {
+            continue;
+        }
+        out << (firstOperation ? "" : ",") << "{\"name\":"; writeJSONString(out, operation.name);
+        out << ",\"threads\":" << operation.threads;
+        out << ",\"complexity\":\"" << EAlgorithmComplexityToIdentifier(operation.complexity) << '"';
+        out << ",\"goodnessOfFit\":"; writeNumber(out, operation.goodnessOfFit, "null");
+        out << ",\"constantNS\":";    writeNumber(out, operation.constantNS, "null");
+        out << ",\"p99Complexity\":" << (operation.p99Measured ? "\""s + EAlgorithmComplexityToIdentifier(operation.p99Complexity) + '"' : "null"s);
+        out << ",\"p99GoodnessOfFit\":"; writeNumber(out, operation.p99Measured ? operation.p99GoodnessOfFit : NAN, "null");
+        out << ",\"passes\":[";
+        for (size_t k=0; k<operation.passes.size(); k++) {
+            const Pass& pass = operation.passes[k];
+            out << (k == 0 ? "" : ",") << "{\"firstN\":" << pass.firstN << ",\"lastN\":" << pass.lastN << ",\"operations\":" << pass.operations
+                << ",\"durationUS\":" << pass.durationUS << ",\"usPerOperation\":";
+            writeNumber(out, pass.operations == 0 ? NAN : ((double)pass.durationUS) / ((double)pass.operations), "null");
+            out << '}';
+        }
+        out << "],\"exceptions\":[";
+        for (size_t e=0; e<operation.exceptions.size(); e++) {
+            out << (e == 0 ? "" : ",");
+            writeJSONString(out, operation.exceptions[e]);
+        }
+        out << "]}";
+        firstOperation = false;
+    }
+    out << "]}\n";
+}
+
+void AlgorithmComplexityAndReentrancyAnalysis::ComplexityAnalysisResult::writeCSVHeader(ostream& out) {
+    out << "testName,method,hostName,unixTimeS,operation,threads,complexity,goodnessOfFit,constantNS,p99Complexity,p99GoodnessOfFit,pass,firstN,lastN,operations,durationUS,usPerOperation,exceptions\n";
+}
+
+void AlgorithmComplexityAndReentrancyAnalysis::ComplexityAnalysisResult::writeCSV(ostream& out) const {
+    for (const Operation& operation : operations) {
+        if (operation.threads <= 0) {
+            continue;
+        }
+        for (size_t k=0; k<operation.passes.size(); k++) {
+            const Pass& pass = operation.passes[k];
+            writeCSVString(out, testName);       out << ',';
+            writeCSVString(out, method);         out << ',';
+            writeCSVString(out, hostName);       out << ',' << unixTimeS << ',';
+            writeCSVString(out, operation.name); out << ',' << operation.threads << ',' << EAlgorithmComplexityToIdentifier(operation.complexity) << ',';
+            writeNumber(out, operation.goodnessOfFit, "");
+            out << ',';
+            writeNumber(out, operation.constantNS, "");
+            out << ',' << (operation.p99Measured ? EAlgorithmComplexityToIdentifier(operation.p99Complexity) : ""s) << ',';
+            writeNumber(out, operation.p99Measured ? operation.p99GoodnessOfFit : NAN, "");
+            out << ',' << (k+1) << ',' << pass.firstN << ',' << pass.lastN << ',' << pass.operations << ',' << pass.durationUS << ',';
+            writeNumber(out, pass.operations == 0 ? NAN : ((double)pass.durationUS) / ((double)pass.operations), "");
+            out << ',' << operation.exceptions.size() << '\n';
+        }
+    }
+}
@@ -4,7 +4,22 @@
 
 #include <string>
 #include <tuple>
+#include <array>
 #include <vector>
+#include <ostream>
+#include <functional>
+#include <memory>
+
+#include "LatencyHistogram.h"
+#include "ThreadPlacement.h"
+#include "PerformanceCounters.h"
+#include "AllocationTracker.h"
+#include "PrecisionClock.h"
+#include "OperationTimeline.h"
+#include "KeyDistribution.h"
+#include "InstrumentedLocks.h"
+#include "CacheHierarchy.h"
+#include "OperationHistory.h"
 
 using namespace std;
 
@@ -44,8 +59,9 @@ namespace mutua::testutils {
      * Notes:
      *  - We seek to build algorithms (and database queries) that are have O(1) complexity -- meaning the performance
      *    will not deteriorate over time, when the number of elements gets bigger and bigger;
-     *  - This class will not test specifically for O(n*log(n)) and O(n^2), for they are so undesirable that we assume they
+     *  - The two passes analysis will not test specifically for O(n*log(n)) and O(n^2), for they are so undesirable that we assume they
      *    will could only occur during the development phase. If those cases happen, we will only say "greater than O(log(n))".
+     *    The sweep analysis, having more data points, tells O(log^2(n)), O(sqrt(n)), O(n*log(n)) and O(n^2) apart.
      *
      * That being said, we're lead to the following usable formulas:
      *
@@ -63,13 +79,19 @@ namespace mutua::testutils {
      * O(n)      when  t2 / t1  /  (n2 / n1)         ~= 1 for any p
      * O(log n)  when  t2 / t1  /  log(n2) / log(n1) ~= 1 for any p
      *
+     * Sweep Analysis: instead of two passes, K passes may be done on geometrically growing data set sizes -- n, 2n, 4n, ... -- and the
+     *                 per operation times fitted, by least squares, against t(1) = a + c * f(n) for each complexity model. The model with the
+     *                 least (small sample corrected) Akaike Information Criterion is elected -- so a model only wins with an extra parameter
+     *                 if it pays for it -- and the goodness of fit tells how much it may be trusted.
+     *
      *
      * Reentrancy Analysis:
      * ===================
      *
      * Methodology: We will insert, select, update and delete (all at the same time) the same number of elements and
      *              by the same routines as in the algorithm complexity analysis phase, with the following constraints:
-     *              - All operations are performed by their own threads -- therefore, we'll have multiples of 4 threads;
+     *              - All operations are performed by their own threads -- one or more for each operation, claiming chunks
+     *                of elements from a shared cursor;
      *              - Insertions occur freely, at the maximum speed;
      *              - Selections occur only for already inserted elements;
      *              - Updates occur only for already selected elements;
@@ -82,20 +104,172 @@ namespace mutua::testutils {
 
     private:
         const string testName;
-        const int    inserts;
-        const int    selects;
-        const int    updates;
-        const int    deletes;
+        int          inserts;       // not const: see 'autoSizeElements'
+        int          selects;
+        int          updates;
+        int          deletes;
+
+        // per operation latency histograms
+        bool                     measureLatencies;
+        vector<LatencyHistogram> insertLatencyHistograms;     // one for each pass of the last complexity analysis
+        vector<LatencyHistogram> selectLatencyHistograms;
+        vector<LatencyHistogram> updateLatencyHistograms;
+        vector<LatencyHistogram> deleteLatencyHistograms;
+
+        // per operation performance counters
+        bool                                measurePerformanceCounters;
+        vector<PerformanceCounters::Values> insertPerformanceCounters;   // one for each pass of the last complexity analysis, summed for all threads
+        vector<PerformanceCounters::Values> selectPerformanceCounters;
+        vector<PerformanceCounters::Values> updatePerformanceCounters;
+        vector<PerformanceCounters::Values> deletePerformanceCounters;
+
+        // insert passes space usage
+        bool                              trackAllocations;
+        vector<AllocationTracker::Values> insertAllocations;          // one for each pass of the last complexity analysis, summed for all threads
+        vector<long long>                 insertResidentSetSizeDeltas; // RSS growth, in bytes, of each pass
+
+        // per insert timeline, for amortized cost spikes
+        bool                     recordTimelines;
+        OperationTimeline        insertTimeline;              // both insert passes of the last complexity analysis
+        static constexpr unsigned int amortizedAnalysisFirstN = 64;   // smaller data sets are left out of the amortized analysis -- mostly warm up noise
+
+        // CPUs the analysis threads run on
+        ThreadPlacement          threadPlacement;
+
+        // elements each operation works on
+        KeyDistribution          keyDistribution;
+
+        // times individual operations -- for latency histograms & reentrancy tests
+        PrecisionClock           clock;
+
+        // adaptive warm up steady state criteria -- see 'setWarmUp'
+        double                   warmUpMaximumCoefficientOfVariation;
+        unsigned int             warmUpWindowBatches;
+        double                   warmUpTimeBudgetS;
+
+        // opt-in per operation history, checked for linearizability -- see 'enableHistoryRecording'
+        unsigned int                       historyEventsPerThread;      // 0: disabled
+        unique_ptr<OperationHistory>       lastHistory;
+
+        /** Builds the latency percentiles report of each pass of 'operation', where 'ns' are the data set sizes on each pass */
+        static string latencyHistogramsReport(const string& operation, const vector<LatencyHistogram>& histograms, const vector<unsigned int>& ns);
 
     public:
 
         enum class EAlgorithmComplexity {
-            BetterThanO1, O1, Ologn, BetweenOLogNAndOn, On, WorseThanOn
+            BetterThanO1, O1, Ologn, Olog2n, Osqrtn, BetweenOLogNAndOn, On, Onlogn, On2, WorseThanOn
         };
 
         /** Returns an human explanation of {@link #EAlgorithmComplexity} */
         static string EAlgorithmComplexityToString(EAlgorithmComplexity complexity);
 
+        /** Returns the {@link #EAlgorithmComplexity} identifier -- "O1", "Ologn", ... -- for machine consumption */
+        static const char* EAlgorithmComplexityToIdentifier(EAlgorithmComplexity complexity);
+
+        /** Machine readable outcome of the last complexity analysis -- see {@link #getLastComplexityAnalysisResult} -- streamable, with no
+          * intermediate allocations, as JSON or CSV for dashboards & regression tracking */
+        struct ComplexityAnalysisResult {
+
+            struct Pass {
+                unsigned int       firstN;          // data set size when the pass started...
+                unsigned int       lastN;           // ... and when it ended -- the same, for selects & updates
+                unsigned int       operations;      // number of operations performed by all threads
+                unsigned long long durationUS;
+            };
+
+            struct Operation {
+                string               name;          // "Insert", "Select", "Update" or "Delete"
+                int                  threads;       // 0 if the operation was not analysed
+                EAlgorithmComplexity complexity;
+                double               goodnessOfFit; // NaN for the two passes analysis, which does no fitting
+                double               constantNS;    // the fitted constant factor, in ns per operation per unit of f(n) -- NaN for the two passes analysis
+                bool                 p99Measured;       // true if latencies were measured -- see {@link #enableLatencyHistograms} -- making the 2 fields below meaningful
+                EAlgorithmComplexity p99Complexity;     // the complexity of the p99 latencies
+                double               p99GoodnessOfFit;  // NaN for the two passes analysis
+                vector<Pass>         passes;
+                vector<string>       exceptions;    // of all passes
+            };
+
+            string              testName;
+            string              method;             // "two passes" or "sweep"
+            // environment
+            string              hostName;
+            string              compiler;
+            int                 onlineCpus;
+            string              threadPlacement;
+            string              keyDistribution;
+            unsigned long long  unixTimeS;          // when the analysis finished
+            array<Operation, 4> operations;         // INSERTs, SELECTs, UPDATEs, DELETEs
+
+            /** Streams this result as a single line JSON object */
+            void writeJSON(ostream& out) const;
+
+            /** Streams the header line matching {@link #writeCSV} */
+            static void writeCSVHeader(ostream& out);
+
+            /** Streams this result as CSV lines -- one for each pass of each analysed operation */
+            void writeCSV(ostream& out) const;
+        };
+
+        /** Operation mix of {@link #analyseMixedWorkload} -- proportions need not add up to 1 */
+        struct MixedWorkload {
+            string name;
+            double insertProportion;
+            double selectProportion;
+            double updateProportion;
+            double deleteProportion;
+            bool   readModifyWrite;     // each update is preceded by a select of the same element, both timed as the update
+
+            /** Returns the YCSB core workload 'A' (50% selects, 50% updates), 'B' (95% selects, 5% updates), 'C' (selects only),
+              * 'D' (95% selects, 5% inserts) or 'F' (50% selects, 50% read-modify-writes). 'E' -- short range scans -- has no
+              * counterpart among the four operations and is refused */
+            static MixedWorkload ycsb(char workload);
+
+            /** Returns "<name> (i% inserts, s% selects, u% updates, d% deletes)" */
+            string toString() const;
+        };
+
+        /** How one operation's throughput grows with the number of threads -- see {@link #analyseScalability} */
+        struct ScalabilityResult {
+            vector<int>    threads;                 // thread counts measured -- empty if the operation was not analysed
+            vector<double> opsPerSecond;            // throughput on each of them
+            double         serialFraction;          // Amdahl: S(p) = p / (1 + s*(p-1))
+            double         contention;              // USL sigma: S(p) = p / (1 + sigma*(p-1) + kappa*p*(p-1))
+            double         coherency;               // USL kappa
+            double         peakThreads;             // where the USL throughput peaks -- sqrt((1-sigma)/kappa); if kappa is 0, infinity -- or 1 for sigma >= 1
+            double         goodnessOfFit;           // of the USL speedups, as in {@link #computeAlgorithmAnalysisByRegression}
+        };
+
+        /** The state after one insert / select / update / delete cycle of {@link #analyseSoak} */
+        struct SoakSample {
+            unsigned long long cycle;
+            double             elapsedS;                // since the soak started
+            unsigned long long residentSetSizeBytes;
+            long long          netAllocatedBytes;       // by the operations, since the soak started
+            double             opsPerSecond;            // of the cycle
+        };
+
+        /** How selects & updates slow down as the data set outgrows each cache level -- see {@link #analyseCacheHierarchySweep} */
+        struct CacheSweepResult {
+            /** Data set sizes of one cache level -- or of DRAM, past the last level -- and the complexities fitted on them */
+            struct Regime {
+                string               name;              // "L1d", "L2", ..., "DRAM"
+                unsigned int         firstN;
+                unsigned int         lastN;
+                EAlgorithmComplexity selectComplexity;
+                EAlgorithmComplexity updateComplexity;
+            };
+            double               bytesPerElement;
+            vector<unsigned int> ns;                    // data set sizes measured, ascending
+            vector<double>       selectNS;              // mean time per operation on each size
+            vector<double>       updateNS;
+            EAlgorithmComplexity selectComplexity;      // fitted on all sizes
+            EAlgorithmComplexity updateComplexity;
+            vector<Regime>       regimes;               // the ones with 2 or more sizes measured
+            vector<unsigned int> kneeNs;                // sizes right before the time per operation jumps -- of either operation
+            unsigned int         largestCacheResidentElements;
+        };
+
 
         /** Prepares for algorithm analysis & reentrancy test, with the given number of Inserts, Selects , Updates and Deletes */
         AlgorithmComplexityAndReentrancyAnalysis(string testName, int numberOfInsertElements, int numberOfSelectElements, int numberOfUpdateElements);
@@ -104,6 +278,111 @@ namespace mutua::testutils {
         AlgorithmComplexityAndReentrancyAnalysis(string testName, int elements);
 
 
+        const string& getTestName() const { return testName; }
+
+        /** Returns the number of elements of each operation: {inserts, selects, updates, deletes} */
+        tuple<int, int, int, int> getNumberOfElements() const { return {inserts, selects, updates, deletes}; }
+
+        /** Replaces the number of elements given to the constructor by ones making each complexity analysis pass last about 'targetPassS' seconds:
+          * elements are inserted, on a single thread, in doubling chunks until inserting them all takes 'targetPassS' -- or a single chunk takes
+          * more than 'maximumPassS', or 'maximumElements' are reached -- then selects & updates are timed on them. Counts are extrapolated
+          * linearly from the probes, so one test definition fits both nanosecond scale in memory structures and millisecond scale disk
+          * backed ones. Returns the probing report. */
+        string autoSizeElements(double targetPassS, double maximumPassS, unsigned int maximumElements, bool verbose);
+
+        /** Opt-in for timing each individual operation (in nanoseconds) into per thread latency histograms, so 'analyseComplexity' and
+          * 'analyseComplexitySweep' will also report the p50, p99, p99.9 & max latencies of each pass and compute the complexity
+          * on the p99 latencies -- where O(n) rehashing or rebalancing spikes show up. Adds two clock readings to each operation. */
+        void enableLatencyHistograms(bool enable);
+
+        /** Opt-in for counting, on each thread and around each pass, CPU cycles, instructions, L1d / LLC / dTLB misses, branch misses, page faults
+          * and context switches -- see {@link PerformanceCounters}. 'analyseComplexity' and 'analyseComplexitySweep' will, then, report the per
+          * operation counts of each pass and the complexity of each counter's growth -- telling the cause, not only the symptom, of a worse
+          * than expected complexity. Linux only. */
+        void enablePerformanceCounters(bool enable);
+
+        /** Returns the per pass performance counters measured by the last complexity analysis -- empty if they were not enabled:
+          * {INSERTs, SELECTs, UPDATEs, DELETEs} */
+        tuple<vector<PerformanceCounters::Values>, vector<PerformanceCounters::Values>, vector<PerformanceCounters::Values>, vector<PerformanceCounters::Values>>
+            getPerformanceCounters();
+
+        /** Opt-in for counting, during each insert pass of 'analyseComplexity', the heap allocations of the inserting threads -- see
+          * {@link AllocationTracker} -- and sampling the process' resident set size before & after each pass. The report, then, shows the
+          * allocations, bytes and RSS growth per inserted element and the space complexity, computed on the net allocated bytes. */
+        void enableAllocationTracking(bool enable);
+
+        /** Returns, for each insert pass of the last 'analyseComplexity', the allocations of the inserting threads and the RSS growth in bytes
+          * -- empty if allocation tracking was not enabled: {allocations, rssDeltas} */
+        tuple<vector<AllocationTracker::Values>, vector<long long>> getInsertAllocations();
+
+        /** Pins the threads of the complexity analysis & reentrancy tests to CPUs according to 'placement' -- see {@link ThreadPlacement}.
+          * 'resetTables' is, then, also called restricted to those CPUs, so tables are allocated on the NUMA node(s) that will use them.
+          * The chosen topology is printed on the reports. Default: FLOATING -- the operating system decides */
+        void setThreadPlacement(const ThreadPlacement& placement);
+
+        const ThreadPlacement& getThreadPlacement() const { return threadPlacement; }
+
+        /** Maps the loop index of each operation -- of the complexity analysis & reentrancy tests -- to the element it works on, according
+          * to 'distribution' -- see {@link KeyDistribution}. Tables are computed before each pass, out of the measurements, and read sequentially.
+          * Unless SEQUENTIAL, the per element algorithms are called -- the '...Range' ones can not express the mapped elements -- and the
+          * reentrancy stages all follow the same permutation of the elements. The distribution is printed on the reports.
+          * Default: SEQUENTIAL -- the friendliest access pattern for caches, prefetchers & trees */
+        void setKeyDistribution(const KeyDistribution& distribution);
+
+        const KeyDistribution& getKeyDistribution() const { return keyDistribution; }
+
+        /** Returns the outcome of the last 'analyseComplexity' or 'analyseComplexitySweep' */
+        const ComplexityAnalysisResult& getLastComplexityAnalysisResult() const { return lastComplexityAnalysisResult; }
+
+        /** Sets the clock used to time individual operations -- on latency histograms and reentrancy tests -- see {@link PrecisionClock}.
+          * Its resolution & calibrated overhead are printed on the reports. Default: CLOCK_GETTIME */
+        void setClock(const PrecisionClock& clock);
+
+        const PrecisionClock& getClock() const { return clock; }
+
+        /** Sets when the warm up of the analyses is over: each thread runs batches of inserts, selects, updates & deletes on its own elements until
+          * the coefficient of variation of its latest 'windowBatches' batch times falls below 'maximumCoefficientOfVariation' -- page faults, branch
+          * predictors, CPU frequency ramp up and allocator pools have, then, settled -- or until the elements or 'timeBudgetS' run out.
+          * Default: 5% over 8 batches, within 5s */
+        void setWarmUp(double maximumCoefficientOfVariation, unsigned int windowBatches, double timeBudgetS);
+
+        /** The outcome of a warm up -- see {@link #setWarmUp} */
+        struct WarmUpResult {
+            unsigned long long operations;              // summed for all threads, until all of them settled
+            unsigned long long durationUS;
+            bool               steady;                  // false if the elements or the time budget ran out first
+            double             coefficientOfVariation;  // of the batch times, on the least settled thread
+        };
+
+        /** Returns the outcome of the last warm up of 'analyseComplexity', 'analyseComplexitySweep' or 'analyseScalability' */
+        const WarmUpResult& getLastWarmUp() const { return lastWarmUp; }
+
+        /** Opt-in for recording the duration of every insert of 'analyseComplexity' on an {@link OperationTimeline} -- 4 bytes per insert,
+          * preallocated before the passes -- so the report also tells the amortized from the worst case complexity and the period of the spikes:
+          * a vector or a hash map growing is amortized O(1), but with O(n) spikes every ~2^k inserts, which the pass averages hide completely.
+          * See {@link #computeAmortizedAlgorithmAnalysis}. Adds two clock readings to each insert. */
+        void enableOperationTimelines(bool enable);
+
+        /** Opt-in for recording, on 'testReentrancy' and 'analyseMixedWorkload', every operation's invocation & response clock readings, key and
+          * observed value -- on up to 'eventsPerThread' preallocated events for each thread; 0 disables it -- then checking, after each run, that
+          * the history is linearizable: that every operation seems to have taken effect atomically, at some instant between its invocation and
+          * response. The verdict, with the operations of the offending keys, goes on the report. Algorithms should call
+          * 'OperationHistory::observe(value)' with the value they write or read, else only the presence of the elements is checked.
+          * Adds two clock readings and ~32 bytes of stores to each operation. See {@link OperationHistory} */
+        void enableHistoryRecording(unsigned int eventsPerThread);
+
+        /** Returns the history of the last 'testReentrancy' or 'analyseMixedWorkload' data set size -- nullptr if recording was not enabled */
+        const OperationHistory* getLastHistory() const { return lastHistory.get(); }
+
+        /** Returns the insert timeline of the last 'analyseComplexity' -- empty if timelines were not enabled */
+        const OperationTimeline& getInsertTimeline() const { return insertTimeline; }
+
+        /** Returns the per pass latency histograms measured by the last complexity analysis -- empty if they were not enabled:
+          * {INSERTs, SELECTs, UPDATEs, DELETEs} */
+        tuple<vector<LatencyHistogram>, vector<LatencyHistogram>, vector<LatencyHistogram>, vector<LatencyHistogram>>
+            getLatencyHistograms();
+
+
         enum class EResetOccasion {PRE_WARMUP_RESET, FULL_RESET, FINAL_RESET};
         virtual void resetTables(EResetOccasion occasion) = 0;
 
@@ -115,6 +394,16 @@ namespace mutua::testutils {
         virtual void updateAlgorithm(unsigned int i);
         virtual void deleteAlgorithm(unsigned int i);
 
+        // optional batched versions of the algorithms above, called by the complexity analysis once per thread slice -- with the elements
+        // [begin, end[ -- and defaulting to calling the per element algorithms. Override them to analyse batched or vectorized implementations
+        // and to keep the per element virtual dispatch out of the measurements of nanosecond scale operations.
+        // note: when latency histograms or timelines are enabled -- or the key distribution is not sequential -- they are called with one element at a time.
+
+        virtual void insertRange(unsigned int begin, unsigned int end);
+        virtual void selectRange(unsigned int begin, unsigned int end);
+        virtual void updateRange(unsigned int begin, unsigned int end);
+        virtual void deleteRange(unsigned int begin, unsigned int end);
+
         /**
          * Returns :
          * {
@@ -133,9 +422,147 @@ namespace mutua::testutils {
         >
             analyseComplexity(bool performWarmUp, int insertThreads, int selectThreads, int updateThreads, int deleteThreads, bool verbose);
 
+        /**
+         * Performs the complexity analysis on 'numberOfSizes' geometrically growing data set sizes -- n, 2n, 4n, ... -- where the largest size
+         * is the number of elements given to the constructor. The per operation times are, then, fitted by least squares against each complexity
+         * model (see {@link #computeAlgorithmAnalysisByRegression}), making the analysis resilient to a single hiccuping pass.
+         * Returns :
+         * {
+         *     (string)outputMessages,
+         *     {EAlgorithmComplexity, (double)goodnessOfFit, (vector<ull>)perPassMicroS, (vector<string>:) exceptions, exceptionReportMessages},       // INSERTs
+         *     {EAlgorithmComplexity, (double)goodnessOfFit, (vector<ull>)perPassMicroS, (vector<string>:) exceptions, exceptionReportMessages},       // SELECTs
+         *     {EAlgorithmComplexity, (double)goodnessOfFit, (vector<ull>)perPassMicroS, (vector<string>:) exceptions, exceptionReportMessages},       // UPDATEs
+         *     {EAlgorithmComplexity, (double)goodnessOfFit, (vector<ull>)perPassMicroS, (vector<string>:) exceptions, exceptionReportMessages}        // DELETEs
+         * }
+         **/
+        tuple<string,                                                                                                       // output messages
+              tuple<EAlgorithmComplexity, double, vector<unsigned long long>, vector<string>, vector<string>>,               // INSERTs
+              tuple<EAlgorithmComplexity, double, vector<unsigned long long>, vector<string>, vector<string>>,               // SELECTs
+              tuple<EAlgorithmComplexity, double, vector<unsigned long long>, vector<string>, vector<string>>,               // UPDATEs
+              tuple<EAlgorithmComplexity, double, vector<unsigned long long>, vector<string>, vector<string>>                // DELETEs
+        >
+            analyseComplexitySweep(bool performWarmUp, int numberOfSizes, int insertThreads, int selectThreads, int updateThreads, int deleteThreads, bool verbose);
+
+        /**
+         * Repeats 'analyseComplexity' until, for every analysed operation, the 95% bootstrap confidence interval of the pass 2 / pass 1 time
+         * ratio is narrower than 'maximumRelativeWidth' of the ratio -- or until 'timeBudgetS' seconds run out (after at least 'minimumTrials').
+         * The verdict is taken on the mean pass durations and its confidence is the fraction of bootstrap resamples agreeing with it --
+         * making flaky classifications, on noisy hosts, rare, without wasting machine time on fixed repetition counts.
+         * Returns :
+         * {
+         *     (string)outputMessages, (int)trials, (bool)converged -- false if the time budget ran out first,
+         *     {EAlgorithmComplexity, (double)confidence, (double)ratio, (double)ratioLow, (double)ratioHigh},       // INSERTs
+         *     {EAlgorithmComplexity, (double)confidence, (double)ratio, (double)ratioLow, (double)ratioHigh},       // SELECTs
+         *     {EAlgorithmComplexity, (double)confidence, (double)ratio, (double)ratioLow, (double)ratioHigh},       // UPDATEs
+         *     {EAlgorithmComplexity, (double)confidence, (double)ratio, (double)ratioLow, (double)ratioHigh}        // DELETEs
+         * }
+         * Operations run with 0 threads are not analysed: their confidence, ratio & interval are NaN -- check with 'isnan(confidence)'.
+         **/
+        tuple<string, int, bool,
+              tuple<EAlgorithmComplexity, double, double, double, double>,      // INSERTs
+              tuple<EAlgorithmComplexity, double, double, double, double>,      // SELECTs
+              tuple<EAlgorithmComplexity, double, double, double, double>,      // UPDATEs
+              tuple<EAlgorithmComplexity, double, double, double, double>       // DELETEs
+        >
+            analyseComplexityTrials(bool performWarmUp, int insertThreads, int selectThreads, int updateThreads, int deleteThreads,
+                                    double maximumRelativeWidth, double timeBudgetS, int minimumTrials, bool verbose);
+
+        /**
+         * Runs 'workload' on 'threads' threads, all at the same time, for 'durationS' seconds on each of the ascending data set sizes 'ns':
+         * the data set is first preloaded, untimed, up to each size. Each thread then draws its operations, by the workload proportions,
+         * from a table precomputed out of the measurements:
+         *   - selects & updates work on the preloaded elements, following the key distribution -- see {@link #setKeyDistribution};
+         *   - inserts add elements from the largest size up to the number of insert elements given to the constructor -- each thread on
+         *     its own share of them, so no element is inserted twice. A thread whose share is full deletes instead;
+         *   - deletes remove the oldest element inserted by the same thread -- inserting instead if there is none.
+         * The elements the workload inserted are deleted after each size, so the next preload continues from the previous size.
+         * Reports the aggregate ops/s, the latencies of each operation and -- for 2 or more sizes -- how the mean operation time grows
+         * with the data set, fitted as in {@link #computeAlgorithmAnalysisByRegression}.
+         * Returns :
+         * {
+         *     (string)outputMessages,
+         *     for each size: {(unsigned int)n, (double)opsPerSecond, (array<LatencyHistogram, 4>)latencies -- INSERTs, SELECTs, UPDATEs, DELETEs}
+         * }
+         **/
+        tuple<string, vector<tuple<unsigned int, double, array<LatencyHistogram, 4>>>>
+            analyseMixedWorkload(const MixedWorkload& workload, const vector<unsigned int>& ns, int threads, double durationS, bool verbose);
+
+        /**
+         * Open loop, rate controlled counterpart of {@link #analyseMixedWorkload}: with 'n' elements preloaded, each of the 'threads' threads
+         * issues the operations of 'workload' on a fixed schedule -- 'ratePerThread' operations per second, for 'durationS' seconds -- for
+         * each of the ascending 'ratesPerThread'. Latencies are measured from each operation's intended start, not its actual one, so a stall
+         * is charged to every operation it delays -- as independent clients would see it -- instead of being hidden by the harness waiting
+         * for it (coordinated omission). Threads falling more than 'durationS' behind their schedule give up their remaining operations.
+         * The latency versus throughput curve tells the saturation point: the first rate whose achieved throughput is under 95% of the
+         * offered one -- the capacity being the greatest throughput achieved before it.
+         * Returns :
+         * {
+         *     (string)outputMessages,
+         *     for each rate: {(double)offeredOpsPerSecond -- of all threads, (double)achievedOpsPerSecond,
+         *                     (LatencyHistogram)latencies -- from the intended starts, (LatencyHistogram)serviceTimes -- from the actual starts},
+         *     (double)saturationOpsPerSecond -- the first offered rate found to saturate; NaN if none did
+         * }
+         **/
+        tuple<string, vector<tuple<double, double, LatencyHistogram, LatencyHistogram>>, double>
+            analyseOpenLoop(const MixedWorkload& workload, unsigned int n, int threads, const vector<double>& ratesPerThread, double durationS, bool verbose);
+
+        /**
+         * Soaks the algorithms for 'durationS' seconds -- up to hours -- repeating cycles of inserting the constructor's number of insert
+         * elements, selecting & updating them and deleting them all, with no table resets in between, so whatever a cycle leaves behind
+         * -- leaked memory, fragmentation, tombstones -- builds up. After each cycle, the resident set size, the net bytes the operations
+         * allocated (see {@link AllocationTracker}) and the cycle's throughput are sampled into a ring buffer of the latest 'maximumSamples'
+         * cycles, preallocated so sampling allocates nothing. Trend lines fitted on them -- leaving out the first cycle, which warms up
+         * the allocator -- give the leak rate, in bytes per cycle, and the throughput drift, in % per hour, each with its standard error.
+         * Returns :
+         * {
+         *     (string)outputMessages,
+         *     (vector<SoakSample>)samples -- the latest cycles, oldest first,
+         *     (double)leakBytesPerCycle -- of the net allocated bytes, (double)residentSetSizeBytesPerCycle, (double)throughputDriftPercentPerHour
+         *     -- NaN if there were too few cycles
+         * }
+         **/
+        tuple<string, vector<SoakSample>, double, double, double>
+            analyseSoak(double durationS, int threads, unsigned int maximumSamples, bool verbose);
+
+        /**
+         * Sweeps the data set size across 'caches' -- see {@link CacheHierarchy} -- telling algorithmic growth apart from memory hierarchy
+         * effects: 'pointsPerRegime' geometrically spaced sizes are measured up to L1d, then up to each next level and, past the last one,
+         * in DRAM, up to 4x its size -- boundaries, in elements, taken from 'bytesPerElement' or, if 0, from the net heap bytes of inserting
+         * a probe of elements (see {@link AllocationTracker}). Sizes above the number of insert elements given to the constructor are left out.
+         * On a single thread, so the data set meets one core's private caches, it grows, untimed, to each size; then, after an untimed round
+         * bringing it into the caches, all of its elements are selected, then updated, in rounds of 64Ki operations or more. Unless a key
+         * distribution is set, keys follow a uniform random permutation -- sequential ones would let the prefetchers hide the hierarchy.
+         * The complexity is fitted, as in {@link #computeAlgorithmAnalysisByRegression}, on all sizes and on each regime alone; knees --
+         * steps where the time per operation jumps by 15% or more, growing faster than n^0.25 -- are reported in elements & bytes, next to
+         * the cache boundary they fall on. The largest cache resident shard is the size right before the last level cache knee -- or, if
+         * none was seen, its predicted boundary.
+         * Returns: {(string)outputMessages, (CacheSweepResult)result}
+         **/
+        tuple<string, CacheSweepResult> analyseCacheHierarchySweep(const CacheHierarchy& caches, int pointsPerRegime, double bytesPerElement, bool verbose);
+
+        /**
+         * Measures where each operation stops scaling: the complexity analysis phases are rerun -- from an empty data set, inserting,
+         * selecting, updating & deleting the constructor's number of elements -- with 1, 2, 4, ... threads, up to 'maxThreads' (included),
+         * or the hardware concurrency if 0. Reports the speedup & parallel efficiency of each thread count, the Amdahl and Universal
+         * Scalability Law fits -- see {@link #computeScalabilityByRegression} -- and the thread count where the throughput should peak.
+         * Returns :
+         * {
+         *     (string)outputMessages,
+         *     {ScalabilityResult, ...}      // INSERTs, SELECTs, UPDATEs, DELETEs
+         * }
+         **/
+        tuple<string, array<ScalabilityResult, 4>>
+            analyseScalability(bool performWarmUp, int maxThreads, bool verbose);
+
+        /** Runs the reentrancy tests with one thread for each operation */
         std::string
 			testReentrancy(unsigned int numberOfElements, bool verbose);
 
+        /** Runs the reentrancy tests with the given number of threads for each operation -- threads of the same operation claim chunks of
+          * elements from a shared cursor, while still only operating on elements the previous operation is done with */
+        std::string
+			testReentrancy(unsigned int numberOfElements, int insertThreads, int selectThreads, int updateThreads, int deleteThreads, bool verbose);
+
 
         /** Performs the algorithm analysis for a reasonably large select/update operation (on a database or not).
           * To perform the analysis, two passes of selects/updates of r elements must be done.
@@ -172,6 +599,65 @@ namespace mutua::testutils {
                 const unsigned long int& end2,
                 const unsigned int       n);
 
+        /** Performs the algorithm analysis for any operation measured on K >= 2 passes, by fitting the per operation times against each
+          * complexity model -- t(1) = a + c * f(n), with f(n) in {1, log(n), log^2(n), sqrt(n), n, n*log(n), n^2} -- and electing the one with
+          * the least AICc. The fixed cost 'a' is only fitted with K >= 4 passes and if it comes out non negative -- otherwise t(1) = c * f(n).
+          * For each pass k, 'deltaTs[k]' is the measured duration of 'rs[k]' operations, while the data set went from 'firstNs[k]' to 'lastNs[k]'
+          * elements -- the same value for selects & updates, growing for inserts and shrinking for deletes.
+          * The goodness of fit is 1 - (the root mean squared error / the mean t(1)): 1.0 for a perfect fit, approaching 0 for noise.
+          * Returns: [1] -- the algorithm complexity;
+          *          [2] -- the goodness of fit;
+          *          [3] -- the fitted constant factor 'c', in 'deltaTs' units per operation per unit of f(n) -- the mean t(1) for O(1);
+          *          [4] -- a string with the algorithm analysis report. */
+        static std::tuple<EAlgorithmComplexity, double, double, string> computeAlgorithmAnalysisByRegression(
+                const string&                     operation,
+                const vector<unsigned long long>& deltaTs,
+                const vector<unsigned int>&       firstNs,
+                const vector<unsigned int>&       lastNs,
+                const vector<unsigned int>&       rs);
+
+        /** Performs the amortized vs worst case analysis of the per operation durations on 'timeline': for each octave of n -- [64, 128[, [128, 256[, ...
+          * -- the mean duration gives the amortized complexity and the greatest one, the worst case complexity -- both fitted as in
+          * {@link #computeAlgorithmAnalysisByRegression}. Spikes -- operations taking more than 10x the median -- comparable to their octave's
+          * worst are, then, checked for a period: geometric (every ~r^k operations, like a doubling vector) or arithmetic (every ~g operations).
+          * Returns: [1] -- the amortized algorithm complexity;
+          *          [2] -- the worst case algorithm complexity;
+          *          [3] -- a string with the analysis report, ending with, for instance, "amortized O(1), worst case O(n) every ~2^k inserts". */
+        static std::tuple<EAlgorithmComplexity, EAlgorithmComplexity, string> computeAmortizedAlgorithmAnalysis(
+                const string&            operation,
+                const OperationTimeline& timeline);
+
+        /** Fits the throughputs measured with each thread count -- 'opsPerSecond[k]' with 'threads[k]' threads, 'threads' including 1 --
+          * against Amdahl's law and the Universal Scalability Law, both linearized as p/S(p) - 1 = sigma*(p-1) + kappa*p*(p-1) and solved
+          * by least squares, with non negative coefficients -- Amdahl being the kappa = 0 case. 'result.threads' & 'result.opsPerSecond'
+          * are the measurements; the remaining fields are filled in. Needs 2 or more thread counts -- 3 for kappa to be fitted.
+          * Returns the analysis report, with the speedup & efficiency of each thread count and, for instance,
+          * "--> Amdahl s=0.0500; USL sigma=0.0300, kappa=0.000100: peak at ~98 threads (speedup 25.3)". */
+        static string computeScalabilityByRegression(const string& operation, ScalabilityResult& result);
+
+    private:
+
+        ComplexityAnalysisResult lastComplexityAnalysisResult;
+        WarmUpResult             lastWarmUp;
+
+        /** Resets the tables for, and runs, the adaptive warm up on 'threads' threads -- see {@link #setWarmUp}. Returns the report fragment */
+        string warmUp(int threads);
+
+        /** Starts a {@link ComplexityAnalysisResult} for 'method', filled with the test name & environment metadata */
+        ComplexityAnalysisResult newComplexityAnalysisResult(const string& method) const;
+
+        /** Calls 'resetTables' restricted to the CPUs of the thread placement, so tables are first touched on the right NUMA node(s) */
+        void resetTablesOnPlacementCpus(EResetOccasion occasion);
+
+        /** Builds the space usage report of the insert passes, where 'ns' are the number of inserted elements on each pass */
+        static string allocationsReport(const vector<AllocationTracker::Values>& perPassAllocations, const vector<long long>& residentSetSizeDeltas,
+                                        const vector<unsigned int>& ns);
+
+        /** Builds the per operation performance counters report of each pass of 'operation', where 'rs' are the number of operations of each pass
+          * and 'classify' computes the complexity of a counter given its per pass counts */
+        static string performanceCountersReport(const string& operation, const vector<PerformanceCounters::Values>& perPassCounters, const vector<unsigned int>& rs,
+                                                const function<EAlgorithmComplexity(const string& counterName, const vector<unsigned long long>& perPassCounts)>& classify);
+
     };
 }
 
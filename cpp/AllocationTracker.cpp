@@ -0,0 +1,109 @@
+#include <new>
+#include <cstdio>
+#include <cstdlib>
+#include <malloc.h>
+#include <unistd.h>
+
+#include "AllocationTracker.h"
+using namespace mutua::testutils;
+
+using namespace std;
+
+
+// per thread counters -- trivially constructible, so they may be used by 'operator new' at any moment of a thread's life
+static thread_local bool                          tracking = false;
+static thread_local AllocationTracker::Values     counts;
+
+
+static inline void countAllocation(void* block) {
+    if (tracking && (block != nullptr)) {
+        counts.allocations++;
+        counts.allocatedBytes += malloc_usable_size(block);
+    }
+}
+
+static inline void countDeallocation(void* block) {
+    if (tracking && (block != nullptr)) {
+        counts.deallocations++;
+        counts.deallocatedBytes += malloc_usable_size(block);
+    }
+}
+
+/** 'malloc' with the standard 'operator new' semantics: retries through the new handler and throws 'bad_alloc' if there is none */
+static void* allocate(size_t size, size_t alignment) {
+    if (size == 0) {
+        size = 1;
+    }
+    while (true) {
+        void* block;
+        if (alignment <= __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+            block = malloc(size);
+        } else if (posix_memalign(&block, alignment, size) != 0) {
+            block = nullptr;
+        }
+        if (block != nullptr) {
+            countAllocation(block);
+            return block;
+        }
+        new_handler handler = get_new_handler();
+        if (handler == nullptr) {
+            throw bad_alloc();
+        }
+        handler();
+    }
+}
+
+static void deallocate(void* block) noexcept {
+    countDeallocation(block);
+    free(block);
+}
+
+
+// replaced global allocation functions
+///////////////////////////////////////
+
+void* operator new  (size_t size)                                              { return allocate(size, 0); }
+void* operator new[](size_t size)                                              { return allocate(size, 0); }
+void* operator new  (size_t size, align_val_t alignment)                       { return allocate(size, (size_t)alignment); }
+void* operator new[](size_t size, align_val_t alignment)                       { return allocate(size, (size_t)alignment); }
+void* operator new  (size_t size, const nothrow_t&) noexcept                   { try { return allocate(size, 0); } catch (...) { return nullptr; } }
+void* operator new[](size_t size, const nothrow_t&) noexcept                   { try { return allocate(size, 0); } catch (...) { return nullptr; } }
+void* operator new  (size_t size, align_val_t alignment, const nothrow_t&) noexcept { try { return allocate(size, (size_t)alignment); } catch (...) { return nullptr; } }
+void* operator new[](size_t size, align_val_t alignment, const nothrow_t&) noexcept { try { return allocate(size, (size_t)alignment); } catch (...) { return nullptr; } }
+
+void operator delete  (void* block) noexcept                                   { deallocate(block); }
+void operator delete[](void* block) noexcept                                   { deallocate(block); }
+void operator delete  (void* block, size_t) noexcept                           { deallocate(block); }
+void operator delete[](void* block, size_t) noexcept                           { deallocate(block); }
+void operator delete  (void* block, align_val_t) noexcept                      { deallocate(block); }
+void operator delete[](void* block, align_val_t) noexcept                      { deallocate(block); }
+void operator delete  (void* block, size_t, align_val_t) noexcept              { deallocate(block); }
+void operator delete[](void* block, size_t, align_val_t) noexcept              { deallocate(block); }
+void operator delete  (void* block, const nothrow_t&) noexcept                 { deallocate(block); }
+void operator delete[](void* block, const nothrow_t&) noexcept                 { deallocate(block); }
+void operator delete  (void* block, align_val_t, const nothrow_t&) noexcept    { deallocate(block); }
+void operator delete[](void* block, align_val_t, const nothrow_t&) noexcept    { deallocate(block); }
+
+
+void AllocationTracker::start() {
+    counts   = Values();
+    tracking = true;
+}
+
+
+AllocationTracker::Values AllocationTracker::stop() {
+    tracking = false;
+    return counts;
+}
+
+
+unsigned long long AllocationTracker::getResidentSetSizeBytes() {
+    unsigned long long sizePages, residentPages;
+    FILE* statm = fopen("/proc/self/statm", "r");
+    if (statm == nullptr) {
+        return 0;
+    }
+    int fields = fscanf(statm, "%llu %llu", &sizePages, &residentPages);
+    fclose(statm);
+    return fields == 2 ? residentPages * (unsigned long long)sysconf(_SC_PAGESIZE) : 0;
+}
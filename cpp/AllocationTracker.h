@@ -0,0 +1,61 @@
+//#pragma once
+#ifndef MUTUA_TESTUTILS_ALLOCATIONTRACKER_H
+#define MUTUA_TESTUTILS_ALLOCATIONTRACKER_H
+
+#include <string>
+
+using namespace std;
+
+namespace mutua::testutils {
+
+    /**
+     * AllocationTracker.h
+     * ===================
+     * created Oct 17, 2026
+     *
+     * Counts the heap allocations of the calling thread by replacing the global 'operator new' & 'operator delete' family --
+     * linking this library into a program replaces them for the whole program, but counting only happens on threads which
+     * called 'start()', so the cost elsewhere is a thread local flag check. Bytes are the allocator's usable sizes of each
+     * block, which include the per block rounding actually paid for. Also provides the process' resident set size,
+     * from '/proc/self/statm'.
+     *
+     * Usage: 'start()' on the thread to be measured, run the operations, 'stop()' -- then sum the per thread 'Values'.
+    */
+    class AllocationTracker {
+
+    public:
+
+        struct Values {
+            unsigned long long allocations;
+            unsigned long long deallocations;
+            unsigned long long allocatedBytes;
+            unsigned long long deallocatedBytes;
+
+            constexpr Values() : allocations(0), deallocations(0), allocatedBytes(0), deallocatedBytes(0) {}
+
+            /** Bytes allocated and not yet deallocated -- negative if more was released than acquired */
+            long long getNetBytes() const { return ((long long)allocatedBytes) - ((long long)deallocatedBytes); }
+
+            /** Sums the counts of another thread */
+            Values& operator+=(const Values& other) {
+                allocations      += other.allocations;
+                deallocations    += other.deallocations;
+                allocatedBytes   += other.allocatedBytes;
+                deallocatedBytes += other.deallocatedBytes;
+                return *this;
+            }
+        };
+
+        /** Zeroes & enables the counting of the calling thread's allocations */
+        static void start();
+
+        /** Disables the counting of the calling thread's allocations, returning its counts */
+        static Values stop();
+
+        /** Returns the resident set size of this process, in bytes -- or 0 if '/proc/self/statm' could not be read */
+        static unsigned long long getResidentSetSizeBytes();
+
+    };
+}
+
+#endif //MUTUA_TESTUTILS_ALLOCATIONTRACKER_H
@@ -0,0 +1,110 @@
+#include <string>
+#include <fstream>
+#include <algorithm>
+#include <unistd.h>
+
+#include "CacheHierarchy.h"
+using namespace mutua::testutils;
+
+#include <BetterExceptions.h>
+#include <TimeMeasurements.h>
+using namespace mutua::cpputils;
+
+using namespace std;
+
+
+/** Returns the first line of 'path' -- or "" if it cannot be read */
+static string readSysFile(const string& path) {
+    ifstream file(path);
+    string   line;
+    getline(file, line);
+    return line;
+}
+
+/** Parses the kernel's cache sizes -- "48K", "2048K", "32M" */
+static unsigned long long parseCacheSize(const string& size) {
+    if (size.empty() || !isdigit(size[0])) {
+        return 0;
+    }
+    unsigned long long bytes = stoull(size);
+    switch (size.back()) {
+        case 'K': return bytes * 1024ull;
+        case 'M': return bytes * 1024ull * 1024ull;
+        case 'G': return bytes * 1024ull * 1024ull * 1024ull;
+        default:  return bytes;
+    }
+}
+
+
+CacheHierarchy::CacheHierarchy(const vector<Level>& levels)
+        : levels(levels) {
+    sort(this->levels.begin(), this->levels.end(), [](const Level& a, const Level& b) { return a.level < b.level; });
+    for (size_t i=0; i<this->levels.size(); i++) {
+        if ( (this->levels[i].sizeBytes == 0) || ( (i > 0) && (this->levels[i].level == this->levels[i-1].level) ) ) {
+            THROW_EXCEPTION(std::invalid_argument, "Cache levels must have a size and be distinct -- " + levelName(this->levels[i].level) + " is not");
+        }
+    }
+}
+
+
+CacheHierarchy CacheHierarchy::read(int cpu) {
+    vector<Level> levels;
+    string        cache = "/sys/devices/system/cpu/cpu" + to_string(cpu) + "/cache/";
+    for (int index=0; ; index++) {
+        string directory = cache + "index" + to_string(index) + "/";
+        string type      = readSysFile(directory + "type");
+        if (type.empty()) {
+            break;
+        }
+        string             level     = readSysFile(directory + "level");
+        unsigned long long sizeBytes = parseCacheSize(readSysFile(directory + "size"));
+        string             lineBytes = readSysFile(directory + "coherency_line_size");
+        if ( (type == "Instruction") || level.empty() || (!isdigit(level[0])) || (sizeBytes == 0) ) {
+            continue;
+        }
+        levels.push_back({stoi(level), sizeBytes, (unsigned int)(lineBytes.empty() || !isdigit(lineBytes[0]) ? 64 : stoi(lineBytes))});
+    }
+
+#if defined(_SC_LEVEL1_DCACHE_SIZE)
+    if (levels.empty()) {
+        const int sizeNames[] = {_SC_LEVEL1_DCACHE_SIZE, _SC_LEVEL2_CACHE_SIZE, _SC_LEVEL3_CACHE_SIZE, _SC_LEVEL4_CACHE_SIZE};
+        const int lineNames[] = {_SC_LEVEL1_DCACHE_LINESIZE, _SC_LEVEL2_CACHE_LINESIZE, _SC_LEVEL3_CACHE_LINESIZE, _SC_LEVEL4_CACHE_LINESIZE};
+        for (int level=1; level<=4; level++) {
+            long sizeBytes = sysconf(sizeNames[level-1]);
+            long lineBytes = sysconf(lineNames[level-1]);
+            if (sizeBytes > 0) {
+                levels.push_back({level, (unsigned long long)sizeBytes, (unsigned int)(lineBytes > 0 ? lineBytes : 64)});
+            }
+        }
+    }
+#endif
+
+    return CacheHierarchy(levels);
+}
+
+
+string CacheHierarchy::levelName(int level) {
+    return level == 1 ? "L1d"s : "L" + to_string(level);
+}
+
+
+string CacheHierarchy::bytesToString(unsigned long long bytes) {
+    if ( (bytes >= 1024ull*1024ull*1024ull) && (bytes % (1024ull*1024ull*1024ull) == 0) ) return to_string(bytes / (1024ull*1024ull*1024ull)) + "GiB";
+    if ( (bytes >= 1024ull*1024ull) && (bytes % (1024ull*1024ull) == 0) )                 return to_string(bytes / (1024ull*1024ull)) + "MiB";
+    if ( (bytes >= 1024ull) && (bytes % 1024ull == 0) )                                   return to_string(bytes / 1024ull) + "KiB";
+    if (bytes >= 10ull*1024ull*1024ull) return to_string((bytes + 512ull*1024ull) / (1024ull*1024ull)) + "MiB";
+    if (bytes >= 10ull*1024ull)         return to_string((bytes + 512ull) / 1024ull) + "KiB";
+    return to_string(bytes) + "B";
+}
+
+
+string CacheHierarchy::toString() const {
+    if (levels.empty()) {
+        return "unknown caches";
+    }
+    string description;
+    for (const Level& level : levels) {
+        description += (description.empty() ? "" : ", ") + levelName(level.level) + " " + bytesToString(level.sizeBytes);
+    }
+    return description;
+}
@@ -0,0 +1,56 @@
+//#pragma once
+#ifndef MUTUA_TESTUTILS_CACHEHIERARCHY_H
+#define MUTUA_TESTUTILS_CACHEHIERARCHY_H
+
+#include <string>
+#include <vector>
+
+using namespace std;
+
+namespace mutua::testutils {
+
+    /**
+     * CacheHierarchy.h
+     * ================
+     * created Oct 17, 2026
+     *
+     * The data (or unified) caches of a CPU, from L1 to the last level -- read from '/sys/devices/system/cpu/cpuN/cache' or, if the
+     * kernel does not expose it, from 'sysconf'. Tells where a data set stops fitting each level, so a complexity analysis may tell
+     * algorithmic growth apart from an O(1) structure falling out of L2 or L3 -- see 'analyseCacheHierarchySweep'.
+    */
+    class CacheHierarchy {
+
+    public:
+
+        struct Level {
+            int                level;           // 1 for L1d, 2 for L2, ...
+            unsigned long long sizeBytes;
+            unsigned int       lineBytes;
+        };
+
+    private:
+        vector<Level> levels;                   // ascending, without instruction caches
+
+    public:
+
+        /** The caches of 'cpu' -- empty if they could not be read */
+        static CacheHierarchy read(int cpu = 0);
+
+        /** Explicit levels -- for machines whose caches are not exposed or to simulate others */
+        explicit CacheHierarchy(const vector<Level>& levels);
+
+        const vector<Level>& getLevels() const { return levels; }
+        bool                 isEmpty()   const { return levels.empty(); }
+
+        /** Returns "L1d" for level 1 and "L<level>" for the others */
+        static string levelName(int level);
+
+        /** Returns 'bytes' in the most fitting binary unit: "48KiB", "2MiB", "105MiB" */
+        static string bytesToString(unsigned long long bytes);
+
+        /** Returns the levels & sizes: "L1d 48KiB, L2 2MiB, L3 105MiB" */
+        string toString() const;
+    };
+}
+
+#endif //MUTUA_TESTUTILS_CACHEHIERARCHY_H
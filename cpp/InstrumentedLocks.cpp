@@ -0,0 +1,200 @@
+#include <string>
+#include <vector>
+#include <mutex>
+#include <atomic>
+#include <cstdio>
+
+#include "InstrumentedLocks.h"
+using namespace mutua::testutils;
+
+#include <BetterExceptions.h>
+#include <TimeMeasurements.h>
+using namespace mutua::cpputils;
+
+using namespace std;
+
+
+/** The counters of one lock name on one thread -- only written by the thread, read by anyone computing a snapshot */
+struct LockSlot {
+    atomic<unsigned long long> acquisitions;
+    atomic<unsigned long long> contentions;
+    atomic<unsigned long long> waitNS;
+    atomic<unsigned long long> holdNS;
+    unsigned long long         sharedAcquiredNS;    // when the thread last acquired the lock shared
+
+    LockSlot() : acquisitions(0), contentions(0), waitNS(0), holdNS(0), sharedAcquiredNS(0) {}
+
+    LockStatistics::Values load() const {
+        LockStatistics::Values values;
+        values.acquisitions = acquisitions.load(memory_order_relaxed);
+        values.contentions  = contentions.load(memory_order_relaxed);
+        values.waitNS       = waitNS.load(memory_order_relaxed);
+        values.holdNS       = holdNS.load(memory_order_relaxed);
+        return values;
+    }
+};
+
+/** Adds to a counter only its own thread writes -- no atomic read-modify-write needed */
+static inline void add(atomic<unsigned long long>& counter, unsigned long long value) {
+    counter.store(counter.load(memory_order_relaxed) + value, memory_order_relaxed);
+}
+
+struct ThreadLockSlots;
+
+/** Lock names, the counters of finished threads and the list of running threads' slots -- no allocations besides the names */
+struct LockRegistry {
+    std::mutex             guard;
+    vector<string>         lockNames;
+    LockStatistics::Values finishedThreads[LockStatistics::maximumLockNames];
+    ThreadLockSlots*       runningThreads = nullptr;    // intrusive, doubly linked list
+};
+
+/** Constructed on first use, so it is ready for locks of static storage duration */
+static LockRegistry& lockRegistry() {
+    static LockRegistry registry;
+    return registry;
+}
+
+/** The calling thread's slots -- linked into the registry while the thread runs, then summed into its finished threads' counters */
+struct ThreadLockSlots {
+    LockSlot         slots[LockStatistics::maximumLockNames];
+    ThreadLockSlots* previous;
+    ThreadLockSlots* next;
+
+    ThreadLockSlots();
+    ~ThreadLockSlots();
+};
+
+// set when the calling thread's slots are created -- so threads which never took an instrumented lock pay nothing
+static thread_local ThreadLockSlots* currentThreadLockSlots = nullptr;
+
+ThreadLockSlots::ThreadLockSlots() : previous(nullptr) {
+    LockRegistry&          registry = lockRegistry();
+    lock_guard<std::mutex> lock(registry.guard);
+    next = registry.runningThreads;
+    if (next != nullptr) {
+        next->previous = this;
+    }
+    registry.runningThreads = this;
+    currentThreadLockSlots  = this;
+}
+
+ThreadLockSlots::~ThreadLockSlots() {
+    LockRegistry&          registry = lockRegistry();
+    lock_guard<std::mutex> lock(registry.guard);
+    for (unsigned int lockId=0; lockId<LockStatistics::maximumLockNames; lockId++) {
+        registry.finishedThreads[lockId] += slots[lockId].load();
+    }
+    (previous == nullptr ? registry.runningThreads : previous->next) = next;
+    if (next != nullptr) {
+        next->previous = previous;
+    }
+    currentThreadLockSlots = nullptr;
+}
+
+static inline LockSlot& threadLockSlot(unsigned int lockId) {
+    static thread_local ThreadLockSlots threadLockSlots;
+    return threadLockSlots.slots[lockId];
+}
+
+
+unsigned int LockStatistics::getLockId(const string& lockName) {
+    LockRegistry&          registry = lockRegistry();
+    lock_guard<std::mutex> lock(registry.guard);
+    for (unsigned int lockId=0; lockId<registry.lockNames.size(); lockId++) {
+        if (registry.lockNames[lockId] == lockName) {
+            return lockId;
+        }
+    }
+    if (registry.lockNames.size() == maximumLockNames) {
+        THROW_EXCEPTION(std::length_error, "Cannot register the instrumented lock name '" + lockName + "': all " + to_string(maximumLockNames) +
+                                           " lock names are taken -- locks of the same kind should share a name");
+    }
+    registry.lockNames.push_back(lockName);
+    return registry.lockNames.size() - 1;
+}
+
+string LockStatistics::getLockName(unsigned int lockId) {
+    LockRegistry&          registry = lockRegistry();
+    lock_guard<std::mutex> lock(registry.guard);
+    return lockId < registry.lockNames.size() ? registry.lockNames[lockId] : "#" + to_string(lockId);
+}
+
+vector<LockStatistics::Values> LockStatistics::snapshot() {
+    LockRegistry&          registry = lockRegistry();
+    lock_guard<std::mutex> lock(registry.guard);
+    vector<Values>         values(registry.finishedThreads, registry.finishedThreads + registry.lockNames.size());
+    for (ThreadLockSlots* thread = registry.runningThreads; thread != nullptr; thread = thread->next) {
+        for (unsigned int lockId=0; lockId<values.size(); lockId++) {
+            values[lockId] += thread->slots[lockId].load();
+        }
+    }
+    return values;
+}
+
+vector<LockStatistics::Values> LockStatistics::threadSnapshot() {
+    LockRegistry&          registry = lockRegistry();
+    lock_guard<std::mutex> lock(registry.guard);
+    vector<Values>         values(registry.lockNames.size());
+    if (currentThreadLockSlots != nullptr) {
+        for (unsigned int lockId=0; lockId<values.size(); lockId++) {
+            values[lockId] = currentThreadLockSlots->slots[lockId].load();
+        }
+    }
+    return values;
+}
+
+void LockStatistics::accumulateDifference(vector<Values>& into, const vector<Values>& after, const vector<Values>& before) {
+    if (into.size() < after.size()) {
+        into.resize(after.size());
+    }
+    for (size_t lockId=0; lockId<after.size(); lockId++) {
+        into[lockId] += after[lockId];
+        if (lockId < before.size()) {
+            into[lockId] -= before[lockId];
+        }
+    }
+}
+
+string LockStatistics::report(const string& operation, const vector<Values>& values, unsigned long long operations, unsigned long long threadsNS) {
+    string report;
+    char   line[512];
+    for (unsigned int lockId=0; lockId<values.size(); lockId++) {
+        const Values& lockValues = values[lockId];
+        if (lockValues.acquisitions == 0) {
+            continue;
+        }
+        snprintf(line, sizeof(line), "    %s lock '%s': %.2f acquisitions/op, %.2f%% contended; waiting %.1fns/op -- %.1f%% of the threads' time; held %.1fns per acquisition\n",
+                 operation.c_str(), getLockName(lockId).c_str(),
+                 ((double)lockValues.acquisitions) / ((double)std::max(operations, 1ull)),
+                 ((double)lockValues.contentions) * 100.0 / ((double)lockValues.acquisitions),
+                 ((double)lockValues.waitNS) / ((double)std::max(operations, 1ull)),
+                 ((double)lockValues.waitNS) * 100.0 / ((double)std::max(threadsNS, 1ull)),
+                 ((double)lockValues.holdNS) / ((double)lockValues.acquisitions));
+        report += line;
+    }
+    return report;
+}
+
+void LockStatistics::recordAcquisition(unsigned int lockId, bool contended, unsigned long long waitNS) {
+    LockSlot& slot = threadLockSlot(lockId);
+    add(slot.acquisitions, 1);
+    if (contended) {
+        add(slot.contentions, 1);
+        add(slot.waitNS, waitNS);
+    }
+}
+
+void LockStatistics::recordRelease(unsigned int lockId, unsigned long long holdNS) {
+    add(threadLockSlot(lockId).holdNS, holdNS);
+}
+
+void LockStatistics::recordSharedAcquisition(unsigned int lockId, bool contended, unsigned long long waitNS, unsigned long long acquiredNS) {
+    recordAcquisition(lockId, contended, waitNS);
+    threadLockSlot(lockId).sharedAcquiredNS = acquiredNS;
+}
+
+void LockStatistics::recordSharedRelease(unsigned int lockId, unsigned long long releasedNS) {
+    LockSlot& slot = threadLockSlot(lockId);
+    add(slot.holdNS, releasedNS - slot.sharedAcquiredNS);
+}
@@ -0,0 +1,224 @@
+//#pragma once
+#ifndef MUTUA_TESTUTILS_INSTRUMENTEDLOCKS_H
+#define MUTUA_TESTUTILS_INSTRUMENTEDLOCKS_H
+
+#include <string>
+#include <vector>
+#include <atomic>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+using namespace std;
+
+namespace mutua::testutils {
+
+    /**
+     * InstrumentedLocks.h
+     * ===================
+     * created Oct 17, 2026
+     *
+     * Drop-in replacements for 'std::mutex' & 'std::shared_mutex', plus a spin lock, counting -- on each thread, for each lock name --
+     * the acquisitions, how many of them had to wait, the time spent waiting and the time the lock was held. Locks sharing a name share
+     * their counters, so the thousand bucket locks of a hash table show up as a single line. Counters live in per thread slots, written
+     * only by their own thread, with no atomic read-modify-write, and are summed on demand -- see {@link LockStatistics}.
+     * The uncontended cost is a 'try_lock()' and two 'CLOCK_MONOTONIC' readings.
+     *
+     * 'analyseComplexity' & 'testReentrancy' report, for each operation, the instrumented locks taken by it.
+     *
+     * Usage: InstrumentedMutex writeGuard("writeGuard"); ... std::lock_guard<InstrumentedMutex> lock(writeGuard);
+    */
+    class LockStatistics {
+
+    public:
+
+        /** Distinct lock names a program may use */
+        static constexpr unsigned int maximumLockNames = 64;
+
+        struct Values {
+            unsigned long long acquisitions;
+            unsigned long long contentions;     // acquisitions which found the lock taken
+            unsigned long long waitNS;          // spent waiting for the lock
+            unsigned long long holdNS;          // from the acquisition to the release -- for shared locks, summed for all holders
+
+            constexpr Values() : acquisitions(0), contentions(0), waitNS(0), holdNS(0) {}
+
+            Values& operator+=(const Values& other) {
+                acquisitions += other.acquisitions;
+                contentions  += other.contentions;
+                waitNS       += other.waitNS;
+                holdNS       += other.holdNS;
+                return *this;
+            }
+
+            Values& operator-=(const Values& other) {
+                acquisitions -= other.acquisitions;
+                contentions  -= other.contentions;
+                waitNS       -= other.waitNS;
+                holdNS       -= other.holdNS;
+                return *this;
+            }
+        };
+
+        /** Returns the id of the lock name 'lockName', registering it if needed -- the counters of locks of the same name are shared */
+        static unsigned int getLockId(const string& lockName);
+
+        /** Returns the name registered for 'lockId' */
+        static string getLockName(unsigned int lockId);
+
+        /** Returns the counters of each lock name, indexed by lock id, summed for all threads -- running or finished */
+        static vector<Values> snapshot();
+
+        /** Returns the counters of each lock name, indexed by lock id, of the calling thread only -- so the difference of two of
+          * them tells what the thread did in between, regardless of what other threads did */
+        static vector<Values> threadSnapshot();
+
+        /** Adds 'after' - 'before' to 'into', growing it as needed -- for collecting what each thread did on a phase */
+        static void accumulateDifference(vector<Values>& into, const vector<Values>& after, const vector<Values>& before);
+
+        /** Returns one line for each lock name acquired in 'values', with its acquisitions & wait time for each of the 'operations'
+          * operations of 'operation', the share of contended acquisitions, the share of the threads' time -- 'threadsNS', summed for
+          * all threads -- spent waiting and the mean hold time. Returns an empty string if no lock was acquired. */
+        static string report(const string& operation, const vector<Values>& values, unsigned long long operations, unsigned long long threadsNS);
+
+        // recording, called by the instrumented locks
+        /////////////////////////////////////////////
+
+        static void recordAcquisition(unsigned int lockId, bool contended, unsigned long long waitNS);
+        static void recordRelease(unsigned int lockId, unsigned long long holdNS);
+        /** Shared holders may be many at once, so their acquisition times are kept on the calling thread's slot */
+        static void recordSharedAcquisition(unsigned int lockId, bool contended, unsigned long long waitNS, unsigned long long acquiredNS);
+        static void recordSharedRelease(unsigned int lockId, unsigned long long releasedNS);
+
+        static inline unsigned long long nowNS() {
+            timespec now;
+            clock_gettime(CLOCK_MONOTONIC, &now);
+            return ((unsigned long long)now.tv_sec) * 1'000'000'000ull + (unsigned long long)now.tv_nsec;
+        }
+
+    };
+
+
+    /** A test-and-test-and-set spin lock -- for very short critical sections */
+    class SpinLock {
+        atomic<bool> locked;
+    public:
+        SpinLock() : locked(false) {}
+
+        void lock() {
+            while (locked.exchange(true, memory_order_acquire)) {
+                while (locked.load(memory_order_relaxed)) {
+#if defined(__x86_64__) || defined(__i386__)
+                    _mm_pause();
+#else
+                    this_thread::yield();
+#endif
+                }
+            }
+        }
+
+        bool try_lock() {
+            return (!locked.load(memory_order_relaxed)) && (!locked.exchange(true, memory_order_acquire));
+        }
+
+        void unlock() {
+            locked.store(false, memory_order_release);
+        }
+    };
+
+
+    /** Counts the exclusive acquisitions of the wrapped 'Lockable' on the {@link LockStatistics} of its name */
+    template <typename Lockable>
+    class InstrumentedLock {
+
+    protected:
+        Lockable           lockable;
+        const unsigned int lockId;
+        unsigned long long acquiredNS;      // when the current exclusive holder acquired it
+
+    public:
+
+        explicit InstrumentedLock(const string& lockName)
+                : lockId    (LockStatistics::getLockId(lockName))
+                , acquiredNS(0) {}
+
+        InstrumentedLock(const InstrumentedLock&)            = delete;
+        InstrumentedLock& operator=(const InstrumentedLock&) = delete;
+
+        void lock() {
+            unsigned long long startNS   = LockStatistics::nowNS();
+            bool               contended = !lockable.try_lock();
+            if (contended) {
+                lockable.lock();
+            }
+            acquiredNS = contended ? LockStatistics::nowNS() : startNS;
+            LockStatistics::recordAcquisition(lockId, contended, acquiredNS - startNS);
+        }
+
+        bool try_lock() {
+            if (!lockable.try_lock()) {
+                return false;
+            }
+            acquiredNS = LockStatistics::nowNS();
+            LockStatistics::recordAcquisition(lockId, false, 0);
+            return true;
+        }
+
+        void unlock() {
+            unsigned long long holdNS = LockStatistics::nowNS() - acquiredNS;
+            lockable.unlock();
+            LockStatistics::recordRelease(lockId, holdNS);
+        }
+
+        unsigned int getLockId() const { return lockId; }
+    };
+
+
+    /** Instrumented 'std::mutex' */
+    class InstrumentedMutex: public InstrumentedLock<std::mutex> {
+    public:
+        explicit InstrumentedMutex(const string& lockName = "mutex") : InstrumentedLock(lockName) {}
+    };
+
+    /** Instrumented {@link SpinLock} */
+    class InstrumentedSpinLock: public InstrumentedLock<SpinLock> {
+    public:
+        explicit InstrumentedSpinLock(const string& lockName = "spin lock") : InstrumentedLock(lockName) {}
+    };
+
+    /** Instrumented 'std::shared_mutex' -- shared & exclusive acquisitions share the counters of its name */
+    class InstrumentedSharedMutex: public InstrumentedLock<std::shared_mutex> {
+    public:
+        explicit InstrumentedSharedMutex(const string& lockName = "shared mutex") : InstrumentedLock(lockName) {}
+
+        void lock_shared() {
+            unsigned long long startNS   = LockStatistics::nowNS();
+            bool               contended = !lockable.try_lock_shared();
+            if (contended) {
+                lockable.lock_shared();
+            }
+            unsigned long long sharedAcquiredNS = contended ? LockStatistics::nowNS() : startNS;
+            LockStatistics::recordSharedAcquisition(lockId, contended, sharedAcquiredNS - startNS, sharedAcquiredNS);
+        }
+
+        bool try_lock_shared() {
+            if (!lockable.try_lock_shared()) {
+                return false;
+            }
+            LockStatistics::recordSharedAcquisition(lockId, false, 0, LockStatistics::nowNS());
+            return true;
+        }
+
+        void unlock_shared() {
+            unsigned long long releasedNS = LockStatistics::nowNS();
+            lockable.unlock_shared();
+            LockStatistics::recordSharedRelease(lockId, releasedNS);
+        }
+    };
+}
+
+#endif //MUTUA_TESTUTILS_INSTRUMENTEDLOCKS_H
@@ -0,0 +1,160 @@
+#include <string>
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <cstdio>
+#include <math.h>
+
+#include "KeyDistribution.h"
+using namespace mutua::testutils;
+
+#include <BetterExceptions.h>
+#include <TimeMeasurements.h>
+using namespace mutua::cpputils;
+
+using namespace std;
+
+
+string KeyDistribution::EKeyDistributionToString(EKeyDistribution distribution) {
+    switch (distribution) {
+        case EKeyDistribution::SEQUENTIAL:
+            return "sequential"s;
+        case EKeyDistribution::REVERSE:
+            return "reverse"s;
+        case EKeyDistribution::UNIFORM_RANDOM:
+            return "uniform random"s;
+        case EKeyDistribution::ZIPFIAN:
+            return "Zipfian"s;
+        case EKeyDistribution::HOTSPOT:
+            return "hotspot"s;
+        default:
+            return "unpredicted key distribution -- update 'KeyDistribution' source code to account for such case"s;
+    }
+}
+
+
+KeyDistribution::KeyDistribution()
+        : KeyDistribution(EKeyDistribution::SEQUENTIAL) {}
+
+
+KeyDistribution::KeyDistribution(EKeyDistribution distribution, unsigned long long seed)
+        : distribution         (distribution)
+        , theta                (0.0)
+        , hotOperationsFraction(0.0)
+        , hotKeysFraction      (0.0)
+        , seed                 (seed) {}
+
+
+KeyDistribution KeyDistribution::zipfian(double theta, unsigned long long seed) {
+    if ( (theta <= 0.0) || (theta >= 1.0) ) {
+        THROW_EXCEPTION(std::invalid_argument, "Zipfian skew must be in ]0, 1[ -- got " + to_string(theta));
+    }
+    KeyDistribution keyDistribution(EKeyDistribution::ZIPFIAN, seed);
+    keyDistribution.theta = theta;
+    return keyDistribution;
+}
+
+
+KeyDistribution KeyDistribution::hotspot(double hotOperationsFraction, double hotKeysFraction, unsigned long long seed) {
+    if ( (hotOperationsFraction < 0.0) || (hotOperationsFraction > 1.0) || (hotKeysFraction <= 0.0) || (hotKeysFraction >= 1.0) ) {
+        THROW_EXCEPTION(std::invalid_argument, "Hotspot fractions must be in [0, 1] for the operations and in ]0, 1[ for the elements -- got " +
+                                               to_string(hotOperationsFraction) + " & " + to_string(hotKeysFraction));
+    }
+    KeyDistribution keyDistribution(EKeyDistribution::HOTSPOT, seed);
+    keyDistribution.hotOperationsFraction = hotOperationsFraction;
+    keyDistribution.hotKeysFraction       = hotKeysFraction;
+    return keyDistribution;
+}
+
+
+vector<unsigned int> KeyDistribution::permutation(unsigned int first, unsigned int count) const {
+    vector<unsigned int> keys(count);
+    iota(keys.begin(), keys.end(), first);
+    if (distribution == EKeyDistribution::REVERSE) {
+        reverse(keys.begin(), keys.end());
+    } else if (distribution != EKeyDistribution::SEQUENTIAL) {
+        mt19937_64 random(seed ^ first);
+        shuffle(keys.begin(), keys.end(), random);
+    }
+    return keys;
+}
+
+
+vector<unsigned int> KeyDistribution::sample(unsigned int populationSize, unsigned int count) const {
+    vector<unsigned int> keys(count);
+    if (populationSize == 0) {
+        if (count > 0) {
+            THROW_EXCEPTION(std::invalid_argument, "Cannot sample " + to_string(count) + " keys from an empty data set");
+        }
+        return keys;
+    }
+    mt19937_64 random(seed ^ populationSize);
+    switch (distribution) {
+        case EKeyDistribution::SEQUENTIAL:
+            for (unsigned int i=0; i<count; i++) {
+                keys[i] = i % populationSize;
+            }
+            break;
+        case EKeyDistribution::REVERSE:
+            for (unsigned int i=0; i<count; i++) {
+                keys[i] = populationSize-1 - (i % populationSize);
+            }
+            break;
+        case EKeyDistribution::UNIFORM_RANDOM: {
+            uniform_int_distribution<unsigned int> uniform(0, populationSize-1);
+            for (unsigned int& key : keys) {
+                key = uniform(random);
+            }
+            break;
+        }
+        case EKeyDistribution::ZIPFIAN: {
+            // Gray et al., "Quickly Generating Billion-Record Synthetic Databases" -- rank 0 is the most popular...
+            double zetaN = 0.0;
+            for (unsigned int i=1; i<=populationSize; i++) {
+                zetaN += 1.0 / pow((double)i, theta);
+            }
+            double zeta2 = 1.0 + 1.0 / pow(2.0, theta);
+            double alpha = 1.0 / (1.0 - theta);
+            double eta   = (1.0 - pow(2.0 / populationSize, 1.0 - theta)) / (1.0 - zeta2 / zetaN);
+            // ... and ranks are scattered over the key space, so popular elements are not neighbours
+            vector<unsigned int> scatter = KeyDistribution(EKeyDistribution::UNIFORM_RANDOM, seed).permutation(0, populationSize);
+            uniform_real_distribution<double> uniform(0.0, 1.0);
+            for (unsigned int& key : keys) {
+                double       u  = uniform(random);
+                double       uz = u * zetaN;
+                unsigned int rank;
+                if (uz < 1.0) {
+                    rank = 0;
+                } else if (uz < zeta2) {
+                    rank = 1;
+                } else {
+                    rank = std::min((unsigned int)(populationSize * pow(eta*u - eta + 1.0, alpha)), populationSize-1);
+                }
+                key = scatter[rank];
+            }
+            break;
+        }
+        case EKeyDistribution::HOTSPOT: {
+            unsigned int hotKeys = std::max(1u, std::min(populationSize-1, (unsigned int)(populationSize * hotKeysFraction)));
+            uniform_real_distribution<double>      uniform(0.0, 1.0);
+            uniform_int_distribution<unsigned int> hot (0, hotKeys-1);
+            uniform_int_distribution<unsigned int> cold(populationSize == 1 ? 0 : hotKeys, populationSize-1);
+            for (unsigned int& key : keys) {
+                key = uniform(random) < hotOperationsFraction ? hot(random) : cold(random);
+            }
+            break;
+        }
+    }
+    return keys;
+}
+
+
+string KeyDistribution::toString() const {
+    char parameters[96] = "";
+    if (distribution == EKeyDistribution::ZIPFIAN) {
+        snprintf(parameters, sizeof(parameters), " (theta=%.2f)", theta);
+    } else if (distribution == EKeyDistribution::HOTSPOT) {
+        snprintf(parameters, sizeof(parameters), " (%.0f%% of the operations on %.0f%% of the elements)", hotOperationsFraction*100.0, hotKeysFraction*100.0);
+    }
+    return EKeyDistributionToString(distribution) + parameters + (isSequential() ? "" : ", seed " + to_string(seed));
+}
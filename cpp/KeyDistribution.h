@@ -0,0 +1,78 @@
+//#pragma once
+#ifndef MUTUA_TESTUTILS_KEYDISTRIBUTION_H
+#define MUTUA_TESTUTILS_KEYDISTRIBUTION_H
+
+#include <string>
+#include <vector>
+
+using namespace std;
+
+namespace mutua::testutils {
+
+    /**
+     * KeyDistribution.h
+     * =================
+     * created Oct 17, 2026
+     *
+     * Decides which element each operation works on -- mapping the loop index to a key through a table computed before the pass,
+     * so the measured loops only read it sequentially (a prefetcher friendly stream) and the only random accesses are the ones made
+     * by the algorithm under test:
+     *   - SEQUENTIAL:     the loop index itself -- no table is used;
+     *   - REVERSE:        from the last element to the first;
+     *   - UNIFORM_RANDOM: any element, with the same probability;
+     *   - ZIPFIAN:        element popularity follows a power law of skew 'theta' -- 0.99 is the YCSB default -- with the popular
+     *                     elements scattered over the key space;
+     *   - HOTSPOT:        a fraction of the operations goes to a fraction of the elements -- at the beginning of the key space.
+     *
+     * Inserts & deletes must touch each element exactly once, so they get a *permutation* of their elements -- on which ZIPFIAN &
+     * HOTSPOT, meaningless without repetitions, fall back to the uniform random order. Selects & updates get a *sample* of the elements
+     * already present, where keys may repeat. Tables are deterministic for a given seed, so runs are comparable.
+    */
+    class KeyDistribution {
+
+    public:
+
+        enum class EKeyDistribution {
+            SEQUENTIAL, REVERSE, UNIFORM_RANDOM, ZIPFIAN, HOTSPOT
+        };
+
+        /** Returns an human explanation of {@link #EKeyDistribution} */
+        static string EKeyDistributionToString(EKeyDistribution distribution);
+
+    private:
+        EKeyDistribution   distribution;
+        double             theta;                   // ZIPFIAN skew
+        double             hotOperationsFraction;   // HOTSPOT: this fraction of the operations...
+        double             hotKeysFraction;         // ... goes to this fraction of the elements
+        unsigned long long seed;
+
+    public:
+
+        /** SEQUENTIAL distribution */
+        KeyDistribution();
+
+        /** SEQUENTIAL, REVERSE or UNIFORM_RANDOM distribution */
+        explicit KeyDistribution(EKeyDistribution distribution, unsigned long long seed = 0);
+
+        /** ZIPFIAN distribution with skew 0 < 'theta' < 1 */
+        static KeyDistribution zipfian(double theta, unsigned long long seed = 0);
+
+        /** HOTSPOT distribution: 'hotOperationsFraction' of the operations on 'hotKeysFraction' of the elements -- 0.8 & 0.2 for the 80/20 rule */
+        static KeyDistribution hotspot(double hotOperationsFraction, double hotKeysFraction, unsigned long long seed = 0);
+
+        EKeyDistribution getDistribution() const { return distribution; }
+        bool             isSequential()    const { return distribution == EKeyDistribution::SEQUENTIAL; }
+
+        /** Returns the 'count' elements [first, first+count[, each once, in this distribution's order -- for inserts & deletes */
+        vector<unsigned int> permutation(unsigned int first, unsigned int count) const;
+
+        /** Returns 'count' elements drawn, with repetitions, from the 'populationSize' elements [0, populationSize[ -- for selects & updates */
+        vector<unsigned int> sample(unsigned int populationSize, unsigned int count) const;
+
+        /** Describes the distribution & its parameters -- for reports */
+        string toString() const;
+
+    };
+}
+
+#endif //MUTUA_TESTUTILS_KEYDISTRIBUTION_H
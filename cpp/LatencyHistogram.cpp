@@ -0,0 +1,71 @@
+#include <string>
+#include <math.h>
+#include <algorithm>
+
+#include "LatencyHistogram.h"
+using namespace mutua::testutils;
+
+using namespace std;
+
+
+LatencyHistogram::LatencyHistogram()
+        : counts(numberOfBuckets, 0ull)
+        , count (0ull)
+        , sum   (0ull)
+        , min   (~0ull)
+        , max   (0ull) {}
+
+
+unsigned long long LatencyHistogram::highestEquivalentValue(unsigned int bucketIndex) {
+    if (bucketIndex < subBuckets) {
+        return bucketIndex;
+    }
+    unsigned int       magnitude = (bucketIndex - subBuckets) / subBuckets;
+    unsigned long long subBucket = (bucketIndex - subBuckets) % subBuckets;
+    return ((subBuckets + subBucket + 1ull) << magnitude) - 1ull;
+}
+
+
+void LatencyHistogram::merge(const LatencyHistogram& other) {
+    for (unsigned int i=0; i<numberOfBuckets; i++) {
+        counts[i] += other.counts[i];
+    }
+    count += other.count;
+    sum   += other.sum;
+    if (other.min < min) min = other.min;
+    if (other.max > max) max = other.max;
+}
+
+
+void LatencyHistogram::reset() {
+    std::fill(counts.begin(), counts.end(), 0ull);
+    count = 0ull;
+    sum   = 0ull;
+    min   = ~0ull;
+    max   = 0ull;
+}
+
+
+unsigned long long LatencyHistogram::getPercentile(double percentile) const {
+    if (count == 0) {
+        return 0;
+    }
+    unsigned long long target     = std::max(1ull, (unsigned long long)ceil((percentile / 100.0) * ((double)count)));
+    unsigned long long cumulative = 0;
+    for (unsigned int i=0; i<numberOfBuckets; i++) {
+        cumulative += counts[i];
+        if (cumulative >= target) {
+            return std::min(highestEquivalentValue(i), max);
+        }
+    }
+    return max;
+}
+
+
+string LatencyHistogram::toString() const {
+    return "p50="    + to_string(getPercentile(50.0)) +
+           ", p99="   + to_string(getPercentile(99.0)) +
+           ", p99.9=" + to_string(getPercentile(99.9)) +
+           ", max="   + to_string(getMax()) +
+           " ("       + to_string(getCount()) + " ops)";
+}
@@ -0,0 +1,82 @@
+//#pragma once
+#ifndef MUTUA_TESTUTILS_LATENCYHISTOGRAM_H
+#define MUTUA_TESTUTILS_LATENCYHISTOGRAM_H
+
+#include <string>
+#include <vector>
+
+using namespace std;
+
+namespace mutua::testutils {
+
+    /**
+     * LatencyHistogram.h
+     * ==================
+     * created Oct 17, 2026
+     *
+     * Log-bucketed (HDR-style) histogram of operation latencies: values below 2^subBucketBits are counted exactly, while
+     * each greater power of two is split in 2^subBucketBits linear sub-buckets -- giving a ~3% precision on any magnitude,
+     * with a fixed memory footprint.
+     *
+     * Instances are not thread safe: each thread should record on its own histogram -- with no locks nor atomics
+     * on the hot path -- and the per thread histograms should be merged after all threads are done.
+    */
+    class LatencyHistogram {
+
+    public:
+        static constexpr unsigned int subBucketBits    = 5;
+        static constexpr unsigned int subBuckets       = 1 << subBucketBits;
+        static constexpr unsigned int numberOfBuckets  = subBuckets + (64 - subBucketBits) * subBuckets;
+
+    private:
+        vector<unsigned long long> counts;
+        unsigned long long         count;
+        unsigned long long         sum;
+        unsigned long long         min;
+        unsigned long long         max;
+
+        static unsigned int bucketIndex(unsigned long long value) {
+            if (value < subBuckets) {
+                return (unsigned int)value;
+            }
+            unsigned int magnitude = (63 - __builtin_clzll(value)) - subBucketBits;
+            return subBuckets + magnitude*subBuckets + (unsigned int)((value >> magnitude) - subBuckets);
+        }
+
+        /** the greatest value that would be counted on the given bucket */
+        static unsigned long long highestEquivalentValue(unsigned int bucketIndex);
+
+    public:
+
+        LatencyHistogram();
+
+        /** Counts one operation that took 'value' time units (usually nanoseconds) */
+        inline void record(unsigned long long value) {
+            counts[bucketIndex(value)]++;
+            count++;
+            sum += value;
+            if (value < min) min = value;
+            if (value > max) max = value;
+        }
+
+        /** Adds all measurements of 'other' to this histogram */
+        void merge(const LatencyHistogram& other);
+
+        /** Forgets all measurements */
+        void reset();
+
+        unsigned long long getCount() const { return count; }
+        unsigned long long getMin()   const { return count == 0 ? 0 : min; }
+        unsigned long long getMax()   const { return max; }
+        double             getMean()  const { return count == 0 ? 0.0 : ((double)sum) / ((double)count); }
+
+        /** Returns the value below which 'percentile'% (0.0 - 100.0) of the measurements are -- within the bucket precision */
+        unsigned long long getPercentile(double percentile) const;
+
+        /** Returns "p50=..., p99=..., p99.9=..., max=... (count)" */
+        string toString() const;
+
+    };
+}
+
+#endif //MUTUA_TESTUTILS_LATENCYHISTOGRAM_H
@@ -0,0 +1,304 @@
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <unordered_set>
+#include <cstdio>
+
+#include "OperationHistory.h"
+using namespace mutua::testutils;
+
+#include <BetterExceptions.h>
+#include <TimeMeasurements.h>
+using namespace mutua::cpputils;
+
+using namespace std;
+
+
+string OperationHistory::EOperationToString(EOperation operation) {
+    switch (operation) {
+        case EOperation::INSERT:
+            return "insert"s;
+        case EOperation::SELECT:
+            return "select"s;
+        case EOperation::UPDATE:
+            return "update"s;
+        case EOperation::DELETE:
+            return "delete"s;
+        default:
+            return "unpredicted operation -- update 'OperationHistory' source code to account for such case"s;
+    }
+}
+
+
+OperationHistory::OperationHistory(int threads, unsigned int eventsPerThread, const PrecisionClock& clock)
+        : clock       (clock)
+        , threadEvents(threads)
+        , full        (false)
+        , cutTicks    (~0ull) {
+    if ( (threads <= 0) || (eventsPerThread == 0) ) {
+        THROW_EXCEPTION(std::invalid_argument, "An operation history needs, at least, 1 thread and room for 1 event on each");
+    }
+    for (ThreadEvents& buffer : threadEvents) {
+        buffer.events.resize(eventsPerThread);
+        buffer.count = 0;
+    }
+}
+
+
+void OperationHistory::cut() {
+    unsigned long long noCut = ~0ull;
+    cutTicks.compare_exchange_strong(noCut, clock.start());
+    full.store(true);
+}
+
+
+void OperationHistory::clear() {
+    for (ThreadEvents& buffer : threadEvents) {
+        buffer.count = 0;
+    }
+    cutTicks.store(~0ull);
+    full.store(false);
+}
+
+
+unsigned long long OperationHistory::size() const {
+    unsigned long long events = 0;
+    for (const ThreadEvents& buffer : threadEvents) {
+        events += buffer.count;
+    }
+    return events;
+}
+
+
+vector<OperationHistory::Event> OperationHistory::getEvents() const {
+    vector<Event> events;
+    for (const ThreadEvents& buffer : threadEvents) {
+        events.insert(events.end(), buffer.events.begin(), buffer.events.begin() + buffer.count);
+    }
+    return events;
+}
+
+
+/** One operation on the key being checked */
+struct KeyOperation {
+    unsigned long long               invocationTicks;
+    unsigned long long               responseTicks;     // ~0 for optional operations: they may have taken effect at any moment after invoked -- or never
+    long long                        value;
+    OperationHistory::EOperation     operation;
+    bool                             failed;
+    bool                             optional;
+    int                              thread;
+};
+
+/** The sequential specification: one element of a map -- absent or holding a value, possibly unknown */
+struct KeyState {
+    bool      present;
+    long long value;
+
+    static bool matches(long long a, long long b) {
+        return (a == OperationHistory::unknownValue) || (b == OperationHistory::unknownValue) || (a == b);
+    }
+
+    /** Applies 'operation', returning false if its outcome is impossible on this state */
+    bool apply(const KeyOperation& operation) {
+        if (operation.failed) {
+            // inserts fail on present elements; the others, on absent ones
+            return operation.operation == OperationHistory::EOperation::INSERT ? present : !present;
+        }
+        switch (operation.operation) {
+            case OperationHistory::EOperation::INSERT:
+                if (present) return false;
+                present = true;
+                value   = operation.value;
+                return true;
+            case OperationHistory::EOperation::SELECT:
+                if ( (!present) || (!matches(value, operation.value)) ) return false;
+                if (value == OperationHistory::unknownValue) value = operation.value;
+                return true;
+            case OperationHistory::EOperation::UPDATE:
+                if (!present) return false;
+                value = operation.value;
+                return true;
+            case OperationHistory::EOperation::DELETE:
+                if ( (!present) || (!matches(value, operation.value)) ) return false;
+                present = false;
+                value   = OperationHistory::unknownValue;
+                return true;
+        }
+        return false;
+    }
+};
+
+enum class ELinearizability {LINEARIZABLE, NOT_LINEARIZABLE, UNDECIDED};
+
+/** Wing & Gong search, with Lowe's memoization, on the operations of one key -- sorted by invocation. The linearized operations are
+  * all the ones before 'prefix' plus the 'extras' after it, which stay few: only operations concurrent to the prefix may be linearized.
+  * Returns the verdict and the most operations linearized on any path */
+static tuple<ELinearizability, size_t> linearize(const vector<KeyOperation>& operations, KeyState initialState, unsigned long long maximumConfigurations) {
+
+    struct Frame {
+        unsigned int         prefix;
+        vector<unsigned int> extras;         // sorted
+        KeyState             state;
+        size_t               mandatoryLeft;
+        vector<unsigned int> candidates;
+        size_t               nextCandidate;
+    };
+
+    size_t mandatory = count_if(operations.begin(), operations.end(), [](const KeyOperation& operation) { return !operation.optional; });
+    if (mandatory == 0) {
+        return {ELinearizability::LINEARIZABLE, 0};
+    }
+
+    // the operations which may be linearized next: invoked before every not yet linearized, mandatory, operation responded
+    auto candidatesOf = [&operations](Frame& frame) {
+        unsigned long long   earliestResponse = ~0ull;
+        vector<unsigned int> scanned;
+        size_t               extra = 0;
+        for (unsigned int i=frame.prefix; (i < operations.size()) && (operations[i].invocationTicks <= earliestResponse); i++) {
+            while ( (extra < frame.extras.size()) && (frame.extras[extra] < i) ) extra++;
+            if ( (extra < frame.extras.size()) && (frame.extras[extra] == i) ) {
+                continue;
+            }
+            scanned.push_back(i);
+            if (!operations[i].optional) {
+                earliestResponse = std::min(earliestResponse, operations[i].responseTicks);
+            }
+        }
+        frame.candidates.clear();
+        for (unsigned int i : scanned) {
+            if (operations[i].invocationTicks <= earliestResponse) {
+                frame.candidates.push_back(i);
+            }
+        }
+        frame.nextCandidate = 0;
+    };
+
+    unordered_set<string> visited;
+    auto configuration = [](const Frame& frame) {
+        string key;
+        key.append((const char*)&frame.prefix, sizeof(frame.prefix));
+        key.append((const char*)frame.extras.data(), frame.extras.size() * sizeof(unsigned int));
+        key.push_back(frame.state.present ? 'p' : 'a');
+        key.append((const char*)&frame.state.value, sizeof(frame.state.value));
+        return key;
+    };
+
+    vector<Frame> stack;
+    stack.push_back({0, {}, initialState, mandatory, {}, 0});
+    candidatesOf(stack.back());
+    size_t mostLinearized = 0;
+    while (!stack.empty()) {
+        Frame& frame = stack.back();
+        if (frame.nextCandidate == frame.candidates.size()) {
+            stack.pop_back();       // a dead end: backtrack
+            continue;
+        }
+        unsigned int candidate = frame.candidates[frame.nextCandidate++];
+        Frame        next{frame.prefix, frame.extras, frame.state, frame.mandatoryLeft, {}, 0};
+        if (!next.state.apply(operations[candidate])) {
+            continue;
+        }
+        if (candidate == next.prefix) {
+            next.prefix++;
+            while ( (!next.extras.empty()) && (next.extras.front() == next.prefix) ) {
+                next.extras.erase(next.extras.begin());
+                next.prefix++;
+            }
+        } else {
+            next.extras.insert(upper_bound(next.extras.begin(), next.extras.end(), candidate), candidate);
+        }
+        next.mandatoryLeft -= operations[candidate].optional ? 0 : 1;
+        mostLinearized      = std::max(mostLinearized, next.prefix + next.extras.size());
+        if (next.mandatoryLeft == 0) {
+            return {ELinearizability::LINEARIZABLE, mostLinearized};
+        }
+        if (!visited.insert(configuration(next)).second) {
+            continue;
+        }
+        if (visited.size() > maximumConfigurations) {
+            return {ELinearizability::UNDECIDED, mostLinearized};
+        }
+        stack.push_back(std::move(next));
+        candidatesOf(stack.back());
+    }
+    return {ELinearizability::NOT_LINEARIZABLE, mostLinearized};
+}
+
+
+tuple<bool, string> OperationHistory::check(const function<bool(unsigned int key)>& initiallyPresent, unsigned long long maximumConfigurationsPerKey) const {
+
+    constexpr size_t maximumReportedKeys       = 8;
+    constexpr size_t reportedOperationsBefore  = 4;     // around the point where the search got stuck
+    constexpr size_t reportedOperationsAfter   = 8;
+
+    unsigned long long startUS = TimeMeasurements::getMonotonicRealTimeUS();
+
+    // all events, by key, then invocation
+    struct KeyedOperation {
+        unsigned int key;
+        KeyOperation operation;
+    };
+    unsigned long long     cut = cutTicks.load();
+    vector<KeyedOperation> keyedOperations;
+    keyedOperations.reserve(size());
+    for (int thread=0; thread<(int)threadEvents.size(); thread++) {
+        const ThreadEvents& buffer = threadEvents[thread];
+        for (size_t i=0; i<buffer.count; i++) {
+            const Event& event    = buffer.events[i];
+            bool         optional = event.responseTicks > cut;
+            keyedOperations.push_back({event.key, {event.invocationTicks, optional ? ~0ull : event.responseTicks, event.value, event.operation, event.failed, optional, thread}});
+        }
+    }
+    sort(keyedOperations.begin(), keyedOperations.end(), [](const KeyedOperation& a, const KeyedOperation& b) {
+        return tie(a.key, a.operation.invocationTicks) < tie(b.key, b.operation.invocationTicks);
+    });
+
+    unsigned long long keys = 0, violations = 0, undecided = 0;
+    string             keyReports;
+    vector<KeyOperation> operations;
+    for (size_t first=0; first<keyedOperations.size(); ) {
+        unsigned int key  = keyedOperations[first].key;
+        size_t       last = first;
+        operations.clear();
+        while ( (last < keyedOperations.size()) && (keyedOperations[last].key == key) ) {
+            operations.push_back(keyedOperations[last++].operation);
+        }
+        first = last;
+        keys++;
+
+        auto [verdict, mostLinearized] = linearize(operations, {initiallyPresent(key), unknownValue}, maximumConfigurationsPerKey);
+        if (verdict == ELinearizability::LINEARIZABLE) {
+            continue;
+        }
+        (verdict == ELinearizability::UNDECIDED ? undecided : violations)++;
+        if (violations + undecided > maximumReportedKeys) {
+            continue;
+        }
+        keyReports += "        key " + to_string(key) + (verdict == ELinearizability::UNDECIDED ? ": UNDECIDED -- more than " + to_string(maximumConfigurationsPerKey) + " configurations searched"
+                                                                                                  : ": NOT LINEARIZABLE") +
+                      "; at most " + to_string(mostLinearized) + " of its " + to_string(operations.size()) + " operations could be ordered" +
+                      (initiallyPresent(key) ? " -- initially present" : " -- initially absent") + ":\n";
+        char line[256];
+        for (size_t i = mostLinearized > reportedOperationsBefore ? mostLinearized - reportedOperationsBefore : 0;
+                    i < std::min(operations.size(), mostLinearized + reportedOperationsAfter); i++) {
+            const KeyOperation& operation = operations[i];
+            string              value     = operation.failed                      ? " (threw)" :
+                                            operation.value == unknownValue        ? ""s :
+                                            operation.operation == EOperation::INSERT || operation.operation == EOperation::UPDATE ? " " + to_string(operation.value)
+                                                                                  : " -> " + to_string(operation.value);
+            string              response  = operation.optional ? "unknown"s :
+                                            "+" + to_string((long long)clock.elapsedNS(operations.front().invocationTicks, operation.responseTicks)) + "ns";
+            snprintf(line, sizeof(line), "            [+%.0fns, %s] thread %d: %s%s%s\n", clock.elapsedNS(operations.front().invocationTicks, operation.invocationTicks),
+                     response.c_str(), operation.thread, EOperationToString(operation.operation).c_str(), value.c_str(), operation.optional ? " -- optional: running when the history was cut" : "");
+            keyReports += line;
+        }
+    }
+
+    bool   linearizable = (violations == 0) && (undecided == 0);
+    string report       = "History: " + to_string(keyedOperations.size()) + " operations on " + to_string(keys) + " keys, by " + to_string(threadEvents.size()) + " threads" +
+                          (isCut() ? " -- cut short: a thread filled its " + to_string(threadEvents.front().events.size()) + " events buffer" : ""s) + " --> " +
+                          (linearizable ? "linearizable"s : "NOT LINEARIZABLE: " + to_string(violations) + " keys violate it, " + to_string(undecided) + " undecided") +
+                          " (checked in " + to_string((TimeMeasurements::getMonotonicRealTimeUS() - startUS) / 1000ull) + "ms)\n" + keyReports;
+    return {linearizable, report};
+}
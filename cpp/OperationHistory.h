@@ -0,0 +1,139 @@
+//#pragma once
+#ifndef MUTUA_TESTUTILS_OPERATIONHISTORY_H
+#define MUTUA_TESTUTILS_OPERATIONHISTORY_H
+
+#include <string>
+#include <vector>
+#include <tuple>
+#include <atomic>
+#include <climits>
+#include <functional>
+
+#include "PrecisionClock.h"
+
+using namespace std;
+
+namespace mutua::testutils {
+
+    /**
+     * OperationHistory.h
+     * ==================
+     * created Oct 17, 2026
+     *
+     * Records, for each operation of a concurrent run, its invocation & response clock readings, its key and the value it wrote or read,
+     * then checks, offline, that the run was linearizable -- catching the lost updates, stale reads & resurrected elements lock-free
+     * structures are prone to, even when no algorithm noticed anything wrong.
+     *
+     * Recording: each thread appends to its own preallocated, cache line aligned buffer -- no locks, no atomic read-modify-write, no
+     * allocations -- so the recorder does not serialize the races it is meant to observe. Algorithms tell the value they wrote (inserts &
+     * updates) or read (selects & deletes) by calling 'observe(value)'; if they do not, only the presence of the elements is checked.
+     * An operation that throws observed its element absent -- or, for inserts, present. Clock readings of different threads must be
+     * comparable: 'CLOCK_GETTIME' always is, RDTSC on CPUs with an invariant TSC. When a buffer fills up, recording stops on all threads
+     * and operations still running at that moment may or may not be taken into account -- so no violation is made up by the cut.
+     *
+     * Checking: as a map is P-compositional, each key's history is checked alone -- against a register which is either absent or holds
+     * a value -- by a Wing & Gong search, memoizing the visited {linearized operations, state} configurations, as proposed by Lowe.
+     *
+     * Usage: see 'AlgorithmComplexityAndReentrancyAnalysis::enableHistoryRecording'.
+    */
+    class OperationHistory {
+
+    public:
+
+        enum class EOperation: unsigned char {
+            INSERT, SELECT, UPDATE, DELETE
+        };
+
+        /** Returns "insert", "select", "update" or "delete" */
+        static string EOperationToString(EOperation operation);
+
+        /** The value of operations whose algorithm did not call 'observe' -- matches any value */
+        static constexpr long long unknownValue = LLONG_MIN;
+
+        struct Event {
+            unsigned long long invocationTicks;
+            unsigned long long responseTicks;
+            long long          value;           // written by inserts & updates, read by selects & deletes -- or 'unknownValue'
+            unsigned int       key;
+            EOperation         operation;
+            bool               failed;          // the algorithm threw
+        };
+
+    private:
+
+        /** A thread's events -- only touched by its own thread while recording */
+        struct alignas(64) ThreadEvents {
+            vector<Event> events;               // preallocated
+            size_t        count;
+        };
+
+        PrecisionClock               clock;
+        vector<ThreadEvents>         threadEvents;
+        atomic<bool>                 full;
+        atomic<unsigned long long>   cutTicks;  // when recording stopped -- operations responding after it are optional
+
+        static inline thread_local long long observedValue = unknownValue;
+
+        /** Stops recording on all threads -- called by the first thread to fill up its buffer */
+        void cut();
+
+    public:
+
+        /** Preallocates 'eventsPerThread' events for each of 'threads' threads, timed by 'clock' */
+        OperationHistory(int threads, unsigned int eventsPerThread, const PrecisionClock& clock);
+
+        OperationHistory(const OperationHistory&)            = delete;
+        OperationHistory& operator=(const OperationHistory&) = delete;
+
+        /** Called by the algorithms, while running an operation, to tell the value they wrote or read */
+        static void observe(long long value) { observedValue = value; }
+
+        /** Runs 'algorithm' -- 'operation' on 'key' -- on the calling thread, the 'thread'th of the run, recording it */
+        template <typename Algorithm>
+        inline void record(int thread, EOperation operation, unsigned int key, Algorithm algorithm) {
+            ThreadEvents& buffer = threadEvents[thread];
+            if ( full.load(memory_order_relaxed) || (buffer.count == buffer.events.size()) ) {
+                if (!full.load(memory_order_relaxed)) {
+                    cut();
+                }
+                algorithm();
+                return;
+            }
+            Event& event = buffer.events[buffer.count++];
+            event.key       = key;
+            event.operation = operation;
+            observedValue   = unknownValue;
+            event.invocationTicks = clock.start();
+            try {
+                algorithm();
+            } catch (...) {
+                event.responseTicks = clock.stop();
+                event.value         = observedValue;
+                event.failed        = true;
+                throw;
+            }
+            event.responseTicks = clock.stop();
+            event.value         = observedValue;
+            event.failed        = false;
+        }
+
+        /** Forgets the recorded events, keeping the buffers -- for the next run */
+        void clear();
+
+        /** Returns the number of recorded events */
+        unsigned long long size() const;
+
+        /** Tells if a buffer filled up, cutting the history short */
+        bool isCut() const { return full.load(); }
+
+        /** Returns the events of all threads, as recorded */
+        vector<Event> getEvents() const;
+
+        /** Checks the recorded history is linearizable, where keys for which 'initiallyPresent' is true start present, with an unknown value,
+          * and the others, absent. Keys whose search exceeds 'maximumConfigurationsPerKey' are left undecided.
+          * Returns: {(bool)linearizable -- false if any key is not or is undecided, (string)report -- one summary line, then one per offending key} */
+        tuple<bool, string> check(const function<bool(unsigned int key)>& initiallyPresent, unsigned long long maximumConfigurationsPerKey = 1'000'000) const;
+    };
+}
+
+#endif //MUTUA_TESTUTILS_OPERATIONHISTORY_H
@@ -0,0 +1,42 @@
+#include <string>
+#include <algorithm>
+
+#include "OperationTimeline.h"
+using namespace mutua::testutils;
+
+using namespace std;
+
+
+OperationTimeline::OperationTimeline(unsigned int numberOfElements)
+        : durationsNS(numberOfElements, unrecorded) {}
+
+
+unsigned int OperationTimeline::getRecordedCount() const {
+    return (unsigned int)count_if(durationsNS.begin(), durationsNS.end(), [](unsigned int ns) { return ns != unrecorded; });
+}
+
+
+double OperationTimeline::getMedianNS() const {
+    vector<unsigned int> recorded;
+    recorded.reserve(durationsNS.size());
+    copy_if(durationsNS.begin(), durationsNS.end(), back_inserter(recorded), [](unsigned int ns) { return ns != unrecorded; });
+    if (recorded.empty()) {
+        return 0.0;
+    }
+    auto middle = recorded.begin() + recorded.size()/2;
+    nth_element(recorded.begin(), middle, recorded.end());
+    return (double)*middle;
+}
+
+
+vector<OperationTimeline::Spike> OperationTimeline::findSpikes(double factor) const {
+    // a zero median -- operations cheaper than the clock overhead -- is taken as 1ns
+    double        thresholdNS = factor * std::max(getMedianNS(), 1.0);
+    vector<Spike> spikes;
+    for (unsigned int n=0; n<durationsNS.size(); n++) {
+        if ( (durationsNS[n] != unrecorded) && (durationsNS[n] > thresholdNS) ) {
+            spikes.push_back({n, durationsNS[n]});
+        }
+    }
+    return spikes;
+}
@@ -0,0 +1,65 @@
+//#pragma once
+#ifndef MUTUA_TESTUTILS_OPERATIONTIMELINE_H
+#define MUTUA_TESTUTILS_OPERATIONTIMELINE_H
+
+#include <string>
+#include <vector>
+
+using namespace std;
+
+namespace mutua::testutils {
+
+    /**
+     * OperationTimeline.h
+     * ===================
+     * created Oct 17, 2026
+     *
+     * Compact series of individual operation durations, indexed by the (estimated) data set size at which each operation
+     * happened -- 4 bytes per operation, preallocated (and page faulted) at construction, so recording neither allocates
+     * nor takes locks: each thread writes only its own slots. Unlike the pass averages or a latency histogram, it keeps
+     * *where* the slow operations happened -- revealing the periodic spikes of amortized algorithms, like a vector growing
+     * or a hash map rehashing.
+     *
+     * Durations are in nanoseconds, saturated at ~4.29s; slots no operation was recorded on are ignored.
+    */
+    class OperationTimeline {
+
+    public:
+        static constexpr unsigned int unrecorded = ~0u;
+
+        /** An operation far slower than the typical one */
+        struct Spike {
+            unsigned int n;             // the data set size when it happened
+            unsigned int durationNS;
+        };
+
+    private:
+        vector<unsigned int> durationsNS;
+
+    public:
+
+        /** Preallocates slots for data set sizes from 0 to 'numberOfElements' - 1 */
+        explicit OperationTimeline(unsigned int numberOfElements = 0);
+
+        /** Records that the operation done when the data set had 'n' elements took 'ns' nanoseconds */
+        inline void record(unsigned int n, unsigned long long ns) {
+            durationsNS[n] = ns < unrecorded ? (unsigned int)ns : unrecorded-1;
+        }
+
+        unsigned int size()                        const { return (unsigned int)durationsNS.size(); }
+        bool         isRecorded(unsigned int n)    const { return durationsNS[n] != unrecorded; }
+        unsigned int getDurationNS(unsigned int n) const { return durationsNS[n]; }
+
+        /** Returns how many operations were recorded */
+        unsigned int getRecordedCount() const;
+
+        /** Returns the median duration of the recorded operations -- the typical, non spiking, cost */
+        double getMedianNS() const;
+
+        /** Returns the operations that took more than 'factor' times the median, ordered by 'n' */
+        vector<Spike> findSpikes(double factor = 10.0) const;
+
+    };
+}
+
+#endif //MUTUA_TESTUTILS_OPERATIONTIMELINE_H
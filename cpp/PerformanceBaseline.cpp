@@ -0,0 +1,254 @@
+#include <string>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <map>
+#include <math.h>
+
+#include "PerformanceBaseline.h"
+using namespace mutua::testutils;
+
+#include <BetterExceptions.h>
+#include <TimeMeasurements.h>
+using namespace mutua::cpputils;
+
+using namespace std;
+
+
+static const array<string, 4> operationNames = {"Insert", "Select", "Update", "Delete"};
+
+static constexpr AlgorithmComplexityAndReentrancyAnalysis::EAlgorithmComplexity allComplexities[] = {
+    AlgorithmComplexityAndReentrancyAnalysis::EAlgorithmComplexity::BetterThanO1, AlgorithmComplexityAndReentrancyAnalysis::EAlgorithmComplexity::O1,
+    AlgorithmComplexityAndReentrancyAnalysis::EAlgorithmComplexity::Ologn,        AlgorithmComplexityAndReentrancyAnalysis::EAlgorithmComplexity::Olog2n,
+    AlgorithmComplexityAndReentrancyAnalysis::EAlgorithmComplexity::Osqrtn,       AlgorithmComplexityAndReentrancyAnalysis::EAlgorithmComplexity::BetweenOLogNAndOn,
+    AlgorithmComplexityAndReentrancyAnalysis::EAlgorithmComplexity::On,           AlgorithmComplexityAndReentrancyAnalysis::EAlgorithmComplexity::Onlogn,
+    AlgorithmComplexityAndReentrancyAnalysis::EAlgorithmComplexity::On2,          AlgorithmComplexityAndReentrancyAnalysis::EAlgorithmComplexity::WorseThanOn,
+};
+
+
+PerformanceBaseline::PerformanceBaseline(const string& testName, const string& directory, double significanceLevel, double minimumSlowdown, unsigned int maximumSamples)
+        : testName         (testName)
+        , significanceLevel(significanceLevel)
+        , minimumSlowdown  (minimumSlowdown)
+        , maximumSamples   (maximumSamples) {
+    // the test name, sanitized into a file name
+    string baseName = testName;
+    replace_if(baseName.begin(), baseName.end(), [](char c) { return !isalnum((unsigned char)c) && (c != '-') && (c != '.'); }, '_');
+    fileName = directory + "/" + baseName + ".baseline";
+    load();
+}
+
+
+bool PerformanceBaseline::isEmpty() const {
+    return all_of(samples.begin(), samples.end(), [](const vector<Sample>& operationSamples) { return operationSamples.empty(); });
+}
+
+
+array<vector<PerformanceBaseline::Sample>, 4> PerformanceBaseline::samplesOf(const vector<ComplexityAnalysisResult>& trials) {
+    array<vector<Sample>, 4> trialSamples;
+    for (const ComplexityAnalysisResult& trial : trials) {
+        for (int operation=0; operation<4; operation++) {
+            const ComplexityAnalysisResult::Operation& result = trial.operations[operation];
+            unsigned long long durationUS = 0, operations = 0;
+            for (const ComplexityAnalysisResult::Pass& pass : result.passes) {
+                durationUS += pass.durationUS;
+                operations += pass.operations;
+            }
+            if ( (result.threads > 0) && (operations > 0) ) {
+                trialSamples[operation].push_back({result.complexity, ((double)durationUS) / ((double)operations)});
+            }
+        }
+    }
+    return trialSamples;
+}
+
+
+void PerformanceBaseline::record(const vector<ComplexityAnalysisResult>& trials) {
+    array<vector<Sample>, 4> trialSamples = samplesOf(trials);
+    for (int operation=0; operation<4; operation++) {
+        samples[operation].insert(samples[operation].end(), trialSamples[operation].begin(), trialSamples[operation].end());
+        if (samples[operation].size() > maximumSamples) {
+            samples[operation].erase(samples[operation].begin(), samples[operation].end() - maximumSamples);
+        }
+    }
+}
+
+
+void PerformanceBaseline::load() {
+    ifstream in(fileName);
+    if (!in) {
+        return;     // no baseline yet
+    }
+    string line;
+    int    lineNumber = 0;
+    while (getline(in, line)) {
+        lineNumber++;
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        istringstream fields(line);
+        string        operationName, complexityIdentifier;
+        double        usPerOperation;
+        if (!(fields >> operationName >> complexityIdentifier >> usPerOperation)) {
+            THROW_EXCEPTION(std::runtime_error, "Malformed performance baseline '" + fileName + "', line " + to_string(lineNumber) + ": '" + line + "'");
+        }
+        auto operation  = find(operationNames.begin(), operationNames.end(), operationName);
+        auto complexity = find_if(begin(allComplexities), end(allComplexities), [&complexityIdentifier](EAlgorithmComplexity c) {
+            return complexityIdentifier == AlgorithmComplexityAndReentrancyAnalysis::EAlgorithmComplexityToIdentifier(c);
+        });
+        if ( (operation == operationNames.end()) || (complexity == end(allComplexities)) ) {
+            THROW_EXCEPTION(std::runtime_error, "Unknown operation or complexity on performance baseline '" + fileName + "', line " + to_string(lineNumber) + ": '" + line + "'");
+        }
+        samples[operation - operationNames.begin()].push_back({*complexity, usPerOperation});
+    }
+}
+
+
+void PerformanceBaseline::save() const {
+    ofstream out(fileName, ios::trunc);
+    out << "# performance baseline for '" << testName << "' -- operation, complexity & microseconds per operation of each recorded run\n";
+    out.precision(17);
+    for (int operation=0; operation<4; operation++) {
+        for (const Sample& sample : samples[operation]) {
+            out << operationNames[operation] << ' ' << AlgorithmComplexityAndReentrancyAnalysis::EAlgorithmComplexityToIdentifier(sample.complexity) << ' ' << sample.usPerOperation << '\n';
+        }
+    }
+    out.flush();
+    if (!out) {
+        THROW_EXCEPTION(std::runtime_error, "Could not write the performance baseline '" + fileName + "'");
+    }
+}
+
+
+double PerformanceBaseline::mannWhitneyUGreaterPValue(const vector<double>& candidate, const vector<double>& baseline) {
+    size_t m = candidate.size();
+    size_t n = baseline.size();
+    if ( (m == 0) || (n == 0) ) {
+        return 1.0;
+    }
+
+    // U: the number of (candidate, baseline) pairs where the candidate is greater -- ties count as half
+    double u    = 0.0;
+    bool   ties = false;
+    for (double x : candidate) {
+        for (double y : baseline) {
+            if (x > y) {
+                u += 1.0;
+            } else if (x == y) {
+                u   += 0.5;
+                ties = true;
+            }
+        }
+    }
+
+    if ( (!ties) && (m*n <= 1000) ) {
+        // exact distribution: counts[m'][n'][u'] is the number of orderings of m' candidate & n' baseline values yielding U = u' --
+        // the greatest value is either a candidate one, beating all n' baseline values, or a baseline one, beating none
+        vector<vector<vector<double>>> counts(m+1, vector<vector<double>>(n+1));
+        for (size_t i=0; i<=m; i++) {
+            for (size_t j=0; j<=n; j++) {
+                counts[i][j].assign(i*j + 1, 0.0);
+                if ( (i == 0) || (j == 0) ) {
+                    counts[i][j][0] = 1.0;
+                    continue;
+                }
+                for (size_t k=0; k<=i*j; k++) {
+                    counts[i][j][k] = (k >= j ? counts[i-1][j][k-j] : 0.0) +
+                                      (k <= i*(j-1) ? counts[i][j-1][k] : 0.0);
+                }
+            }
+        }
+        double total = 0.0, atLeastU = 0.0;
+        for (size_t k=0; k<=m*n; k++) {
+            total += counts[m][n][k];
+            if (k >= (size_t)u) {
+                atLeastU += counts[m][n][k];
+            }
+        }
+        return atLeastU / total;
+    }
+
+    // normal approximation, with tie & continuity corrections -- for ties or large samples
+    vector<double> all(candidate);
+    all.insert(all.end(), baseline.begin(), baseline.end());
+    sort(all.begin(), all.end());
+    double tieCorrection = 0.0;
+    for (size_t i=0; i<all.size(); ) {
+        size_t j = i;
+        while ( (j < all.size()) && (all[j] == all[i]) ) j++;
+        double t = (double)(j - i);
+        tieCorrection += t*t*t - t;
+        i = j;
+    }
+    double total = (double)(m + n);
+    double mean  = ((double)(m*n)) / 2.0;
+    double sigma = sqrt( ((double)(m*n)) / 12.0 * ((total + 1.0) - tieCorrection / (total * (total - 1.0))) );
+    if (sigma == 0.0) {
+        return 1.0;
+    }
+    double z = (u - mean - 0.5) / sigma;
+    return 0.5 * erfc(z / sqrt(2.0));
+}
+
+
+/** Returns the median of 'values' */
+static double median(vector<double> values) {
+    sort(values.begin(), values.end());
+    size_t middle = values.size() / 2;
+    return values.size() % 2 == 1 ? values[middle] : (values[middle-1] + values[middle]) / 2.0;
+}
+
+/** Returns the most frequent complexity of 'samples' and how many samples agree on it */
+static pair<AlgorithmComplexityAndReentrancyAnalysis::EAlgorithmComplexity, size_t> mostFrequentComplexity(const vector<PerformanceBaseline::Sample>& samples) {
+    map<AlgorithmComplexityAndReentrancyAnalysis::EAlgorithmComplexity, size_t> frequencies;
+    for (const PerformanceBaseline::Sample& sample : samples) {
+        frequencies[sample.complexity]++;
+    }
+    auto mostFrequent = max_element(frequencies.begin(), frequencies.end(), [](auto& a, auto& b) { return a.second < b.second; });
+    return {mostFrequent->first, mostFrequent->second};
+}
+
+
+tuple<bool, string> PerformanceBaseline::compare(const vector<ComplexityAnalysisResult>& trials) const {
+    array<vector<Sample>, 4> trialSamples = samplesOf(trials);
+    bool   regressed = false;
+    string report    = testName + " performance baseline comparison ('" + fileName + "'):\n";
+
+    for (int operation=0; operation<4; operation++) {
+        const vector<Sample>& baselineSamples  = samples[operation];
+        const vector<Sample>& candidateSamples = trialSamples[operation];
+        if (candidateSamples.empty()) {
+            continue;
+        }
+        report += "    " + operationNames[operation] + ": ";
+        if (baselineSamples.empty()) {
+            report += "no baseline samples -- passed\n";
+            continue;
+        }
+
+        vector<double> baselineTimes, candidateTimes;
+        for (const Sample& sample : baselineSamples)  baselineTimes.push_back(sample.usPerOperation);
+        for (const Sample& sample : candidateSamples) candidateTimes.push_back(sample.usPerOperation);
+        double baselineMedian  = median(baselineTimes);
+        double candidateMedian = median(candidateTimes);
+        double slowdown        = baselineMedian > 0.0 ? (candidateMedian / baselineMedian) - 1.0 : 0.0;
+        double pValue          = mannWhitneyUGreaterPValue(candidateTimes, baselineTimes);
+        bool   slower          = (pValue < significanceLevel) && (slowdown > minimumSlowdown);
+
+        auto [baselineComplexity,  baselineAgreement]  = mostFrequentComplexity(baselineSamples);
+        auto [candidateComplexity, candidateAgreement] = mostFrequentComplexity(candidateSamples);
+        // the complexity only changed if most trials agree on a worse one
+        bool worseComplexity = (candidateComplexity > baselineComplexity) && (candidateAgreement*2 > candidateSamples.size());
+
+        report += "median " + to_string(candidateMedian) + "us/op (" + to_string(candidateSamples.size()) + " trials, " +
+                  AlgorithmComplexityAndReentrancyAnalysis::EAlgorithmComplexityToIdentifier(candidateComplexity) + ") vs " + to_string(baselineMedian) + "us/op (" +
+                  to_string(baselineSamples.size()) + " samples, " + AlgorithmComplexityAndReentrancyAnalysis::EAlgorithmComplexityToIdentifier(baselineComplexity) + "); " +
+                  (slowdown >= 0.0 ? "+" : "") + to_string(slowdown*100.0) + "%, p=" + to_string(pValue) + " --> " +
+                  (slower && worseComplexity ? "THROUGHPUT & COMPLEXITY REGRESSION" :
+                   slower                    ? "THROUGHPUT REGRESSION" :
+                   worseComplexity           ? "COMPLEXITY REGRESSION" :
+                                               "passed") + "\n";
+        regressed = regressed || slower || worseComplexity;
+    }
+    return {regressed, report};
+}
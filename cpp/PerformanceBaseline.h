@@ -0,0 +1,96 @@
+//#pragma once
+#ifndef MUTUA_TESTUTILS_PERFORMANCEBASELINE_H
+#define MUTUA_TESTUTILS_PERFORMANCEBASELINE_H
+
+#include <string>
+#include <tuple>
+#include <array>
+#include <vector>
+
+#include "AlgorithmComplexityAndReentrancyAnalysis.h"
+
+using namespace std;
+
+namespace mutua::testutils {
+
+    /**
+     * PerformanceBaseline.h
+     * =====================
+     * created Oct 17, 2026
+     *
+     * Persists, between builds, the per operation times & complexity verdicts of repeated runs of a complexity analysis -- one
+     * text file for each test name -- and gates new runs against them:
+     *   - a throughput regression is only reported if the new trials are slower with statistical significance -- by a one sided
+     *     Mann-Whitney U test, exact when there are no ties -- AND the median slowdown is above a minimum, so noise and irrelevant
+     *     differences do not fail the build;
+     *   - a complexity regression is reported when the verdict most trials agree on is worse than the baseline's most frequent one.
+     *
+     * Usage:
+     *   PerformanceBaseline baseline(analysis.getTestName());
+     *   vector<ComplexityAnalysisResult> trials;
+     *   for (int i=0; i<5; i++) { analysis.analyseComplexity(...); trials.push_back(analysis.getLastComplexityAnalysisResult()); }
+     *   auto [regressed, report] = baseline.compare(trials);
+     *   if (!regressed) { baseline.record(trials); baseline.save(); }
+    */
+    class PerformanceBaseline {
+
+    public:
+
+        using EAlgorithmComplexity     = AlgorithmComplexityAndReentrancyAnalysis::EAlgorithmComplexity;
+        using ComplexityAnalysisResult = AlgorithmComplexityAndReentrancyAnalysis::ComplexityAnalysisResult;
+
+        /** One run of one operation */
+        struct Sample {
+            EAlgorithmComplexity complexity;
+            double               usPerOperation;    // of all passes
+        };
+
+    private:
+        string                        testName;
+        string                        fileName;
+        double                        significanceLevel;
+        double                        minimumSlowdown;
+        unsigned int                  maximumSamples;
+        array<vector<Sample>, 4>      samples;          // INSERTs, SELECTs, UPDATEs, DELETEs -- oldest first
+
+    public:
+
+        /** Opens -- loading it, if it exists -- the baseline of 'testName' on 'directory'.
+          * 'significanceLevel' is the Mann-Whitney p-value below which a slowdown is considered real; 'minimumSlowdown' (0.05 = 5%)
+          * is the median slowdown below which it is considered irrelevant; only the newest 'maximumSamples' of each operation are kept. */
+        PerformanceBaseline(const string& testName, const string& directory = ".", double significanceLevel = 0.01, double minimumSlowdown = 0.05,
+                            unsigned int maximumSamples = 50);
+
+        const string& getFileName() const { return fileName; }
+
+        /** Returns the baseline samples of operation #'operation' -- 0: INSERTs, 1: SELECTs, 2: UPDATEs, 3: DELETEs */
+        const vector<Sample>& getSamples(int operation) const { return samples[operation]; }
+
+        /** Tells if there are no baseline samples at all -- on the first run, for instance */
+        bool isEmpty() const;
+
+        /** Adds the samples of 'trials' to the baseline -- to be followed by 'save()' */
+        void record(const vector<ComplexityAnalysisResult>& trials);
+
+        /** Writes the baseline to its file */
+        void save() const;
+
+        /** Checks 'trials' against the baseline -- operations with no baseline samples pass.
+          * Returns: [1] -- true if any operation regressed, either in throughput or complexity;
+          *          [2] -- the comparison report. */
+        tuple<bool, string> compare(const vector<ComplexityAnalysisResult>& trials) const;
+
+        /** Returns the one sided Mann-Whitney U test p-value for the hypothesis that 'candidate' values tend to be greater than 'baseline' ones */
+        static double mannWhitneyUGreaterPValue(const vector<double>& candidate, const vector<double>& baseline);
+
+        /** Returns the per operation samples of 'trials' -- 0: INSERTs, 1: SELECTs, 2: UPDATEs, 3: DELETEs */
+        static array<vector<Sample>, 4> samplesOf(const vector<ComplexityAnalysisResult>& trials);
+
+    private:
+
+        void load();
+
+    };
+}
+
+#endif //MUTUA_TESTUTILS_PERFORMANCEBASELINE_H
@@ -0,0 +1,108 @@
+#include <string>
+#include <cstring>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+
+#include "PerformanceCounters.h"
+using namespace mutua::testutils;
+
+using namespace std;
+
+
+string PerformanceCounters::ECounterToString(ECounter counter) {
+    switch (counter) {
+        case ECounter::CYCLES:
+            return "cycles"s;
+        case ECounter::INSTRUCTIONS:
+            return "instructions"s;
+        case ECounter::L1D_MISSES:
+            return "L1d misses"s;
+        case ECounter::LLC_MISSES:
+            return "LLC misses"s;
+        case ECounter::BRANCH_MISSES:
+            return "branch misses"s;
+        case ECounter::DTLB_MISSES:
+            return "dTLB misses"s;
+        case ECounter::PAGE_FAULTS:
+            return "page faults"s;
+        case ECounter::CONTEXT_SWITCHES:
+            return "context switches"s;
+        default:
+            return "unpredicted performance counter -- update 'PerformanceCounters' source code to account for such case"s;
+    }
+}
+
+
+/** Returns the perf_event 'type' & 'config' for the given counter */
+static pair<unsigned int, unsigned long long> perfEventOf(PerformanceCounters::ECounter counter) {
+    constexpr unsigned long long cacheReadMiss = (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+    switch (counter) {
+        case PerformanceCounters::ECounter::CYCLES:           return {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES};
+        case PerformanceCounters::ECounter::INSTRUCTIONS:     return {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS};
+        case PerformanceCounters::ECounter::L1D_MISSES:       return {PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D  | cacheReadMiss};
+        case PerformanceCounters::ECounter::LLC_MISSES:       return {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES};
+        case PerformanceCounters::ECounter::BRANCH_MISSES:    return {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES};
+        case PerformanceCounters::ECounter::DTLB_MISSES:      return {PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_DTLB | cacheReadMiss};
+        case PerformanceCounters::ECounter::PAGE_FAULTS:      return {PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS};
+        case PerformanceCounters::ECounter::CONTEXT_SWITCHES: return {PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CONTEXT_SWITCHES};
+        default:                                              return {PERF_TYPE_MAX, 0};
+    }
+}
+
+
+PerformanceCounters::PerformanceCounters() {
+    for (int counter=0; counter<numberOfCounters; counter++) {
+        auto [type, config] = perfEventOf((ECounter)counter);
+        perf_event_attr attributes;
+        memset(&attributes, 0, sizeof(attributes));
+        attributes.size           = sizeof(attributes);
+        attributes.type           = type;
+        attributes.config         = config;
+        attributes.disabled       = 1;
+        attributes.exclude_kernel = 1;
+        attributes.exclude_hv     = 1;
+        attributes.read_format    = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+        // this thread, any CPU, no group
+        fds[counter] = (int)syscall(SYS_perf_event_open, &attributes, 0, -1, -1, 0);
+    }
+}
+
+
+PerformanceCounters::~PerformanceCounters() {
+    for (int fd : fds) {
+        if (fd >= 0) close(fd);
+    }
+}
+
+
+void PerformanceCounters::start() {
+    for (int fd : fds) {
+        if (fd >= 0) {
+            ioctl(fd, PERF_EVENT_IOC_RESET,  0);
+            ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+}
+
+
+PerformanceCounters::Values PerformanceCounters::stop() {
+    Values values;
+    for (int counter=0; counter<numberOfCounters; counter++) {
+        if (fds[counter] >= 0) {
+            ioctl(fds[counter], PERF_EVENT_IOC_DISABLE, 0);
+        }
+    }
+    for (int counter=0; counter<numberOfCounters; counter++) {
+        unsigned long long reading[3];      // {value, time enabled, time running}
+        if ( (fds[counter] < 0) || (read(fds[counter], reading, sizeof(reading)) != sizeof(reading)) ) {
+            values.available[counter] = false;
+            continue;
+        }
+        values.counts[counter] = (reading[2] == 0)           ? 0 :
+                                 (reading[2] == reading[1]) ? reading[0] :
+                                                              (unsigned long long)(((double)reading[0]) * ((double)reading[1]) / ((double)reading[2]));
+    }
+    return values;
+}
@@ -0,0 +1,72 @@
+//#pragma once
+#ifndef MUTUA_TESTUTILS_PERFORMANCECOUNTERS_H
+#define MUTUA_TESTUTILS_PERFORMANCECOUNTERS_H
+
+#include <string>
+#include <array>
+
+using namespace std;
+
+namespace mutua::testutils {
+
+    /**
+     * PerformanceCounters.h
+     * =====================
+     * created Oct 17, 2026
+     *
+     * Counts hardware (and a couple of software) events of the calling thread through Linux's 'perf_event_open' -- user space only,
+     * so it works with the default 'perf_event_paranoid' settings. Counters the kernel, the CPU or the hypervisor do not provide
+     * are simply reported as unavailable. Multiplexed counters are scaled by their enabled / running times.
+     *
+     * Usage: open on the thread to be measured, 'start()', run the operations, 'stop()' -- then sum the per thread 'Values'.
+    */
+    class PerformanceCounters {
+
+    public:
+
+        enum class ECounter {
+            CYCLES, INSTRUCTIONS, L1D_MISSES, LLC_MISSES, BRANCH_MISSES, DTLB_MISSES, PAGE_FAULTS, CONTEXT_SWITCHES
+        };
+        static constexpr int numberOfCounters = 8;
+
+        /** Returns an human explanation of {@link #ECounter} */
+        static string ECounterToString(ECounter counter);
+
+        struct Values {
+            array<unsigned long long, numberOfCounters> counts;
+            array<bool,               numberOfCounters> available;
+
+            Values() : counts{}, available{} { available.fill(true); }
+
+            /** Sums the counts of another thread -- a counter is only available if it was available on all threads */
+            Values& operator+=(const Values& other) {
+                for (int counter=0; counter<numberOfCounters; counter++) {
+                    counts[counter]    += other.counts[counter];
+                    available[counter]  = available[counter] && other.available[counter];
+                }
+                return *this;
+            }
+        };
+
+    private:
+        array<int, numberOfCounters> fds;
+
+    public:
+
+        /** Opens the counters for the calling thread -- disabled until 'start()' */
+        PerformanceCounters();
+        ~PerformanceCounters();
+
+        PerformanceCounters(const PerformanceCounters&)            = delete;
+        PerformanceCounters& operator=(const PerformanceCounters&) = delete;
+
+        /** Zeroes & enables all available counters */
+        void start();
+
+        /** Disables all counters, returning their counts */
+        Values stop();
+
+    };
+}
+
+#endif //MUTUA_TESTUTILS_PERFORMANCECOUNTERS_H
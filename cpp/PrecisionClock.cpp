@@ -0,0 +1,109 @@
+#include <string>
+#include <algorithm>
+#include <cstdio>
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#endif
+
+#include "PrecisionClock.h"
+using namespace mutua::testutils;
+
+#include <BetterExceptions.h>
+#include <TimeMeasurements.h>
+using namespace mutua::cpputils;
+
+using namespace std;
+
+
+string PrecisionClock::EClockSourceToString(EClockSource source) {
+    switch (source) {
+        case EClockSource::CLOCK_GETTIME:
+            return "clock_gettime(CLOCK_MONOTONIC)"s;
+        case EClockSource::TSC:
+            return "invariant TSC"s;
+        default:
+            return "unpredicted clock source -- update 'PrecisionClock' source code to account for such case"s;
+    }
+}
+
+
+/** Tells if the CPU reports an invariant -- constant rate, not stopping on idle states -- time stamp counter */
+static bool hasInvariantTsc() {
+#if defined(__x86_64__) || defined(__i386__)
+    unsigned int eax, ebx, ecx, edx;
+    if (__get_cpuid(0x80000000, &eax, &ebx, &ecx, &edx) == 0 || eax < 0x80000007) {
+        return false;
+    }
+    __get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx);
+    return (edx & (1u << 8)) != 0;
+#else
+    return false;
+#endif
+}
+
+
+PrecisionClock::PrecisionClock(EClockSource source)
+        : source       (source)
+        , nsPerTick    (1.0)
+        , overheadTicks(0.0)
+        , resolutionNS (0.0) {
+
+    if ( (source == EClockSource::TSC) && (!hasInvariantTsc()) ) {
+        THROW_EXCEPTION(std::invalid_argument, "This CPU does not provide an invariant TSC -- use the CLOCK_GETTIME clock source instead");
+    }
+
+    // TSC frequency: ticks elapsed while CLOCK_MONOTONIC advances ~10ms
+    if (source == EClockSource::TSC) {
+        unsigned long long startNS    = readMonotonicNS();
+        unsigned long long startTicks = start();
+        unsigned long long nowNS;
+        do {
+            nowNS = readMonotonicNS();
+        } while (nowNS - startNS < 10'000'000ull);
+        unsigned long long stopTicks  = stop();
+        nsPerTick = ((double)(nowNS - startNS)) / ((double)(stopTicks - startTicks));
+    }
+
+    // overhead: the least costly of many empty measurements
+    constexpr int      calibrationRounds = 10'000;
+    unsigned long long leastOverhead     = ~0ull;
+    for (int round=0; round<calibrationRounds; round++) {
+        unsigned long long t0 = start();
+        unsigned long long t1 = stop();
+        leastOverhead = std::min(leastOverhead, t1 - t0);
+    }
+    overheadTicks = (double)leastOverhead;
+
+    // resolution: the tick size -- not the cost of a reading, which consecutive readings differ by
+    if (source == EClockSource::TSC) {
+        resolutionNS = nsPerTick;
+    } else {
+        timespec resolution;
+        if (clock_getres(CLOCK_MONOTONIC, &resolution) == 0) {
+            resolutionNS = (double)resolution.tv_nsec + resolution.tv_sec*1e9;
+        } else {
+            // the least step seen reading until the value changes
+            unsigned long long leastStep = ~0ull;
+            for (int round=0; round<calibrationRounds; round++) {
+                unsigned long long t0 = readMonotonicNS();
+                unsigned long long t1;
+                while ((t1 = readMonotonicNS()) == t0);
+                leastStep = std::min(leastStep, t1 - t0);
+            }
+            resolutionNS = (double)leastStep;
+        }
+    }
+}
+
+
+string PrecisionClock::toString() const {
+    char description[128];
+    if (source == EClockSource::TSC) {
+        snprintf(description, sizeof(description), "%s @ %.3fGHz -- resolution %.2fns, overhead %.2fns (subtracted)",
+                 EClockSourceToString(source).c_str(), 1.0 / nsPerTick, resolutionNS, getOverheadNS());
+    } else {
+        snprintf(description, sizeof(description), "%s -- resolution %.2fns, overhead %.2fns (subtracted)",
+                 EClockSourceToString(source).c_str(), resolutionNS, getOverheadNS());
+    }
+    return description;
+}
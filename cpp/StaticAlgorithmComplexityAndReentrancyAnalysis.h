@@ -0,0 +1,184 @@
+//#pragma once
+#ifndef MUTUA_TESTUTILS_STATICALGORITHMCOMPLEXITYANDREENTRANCYANALYSIS_H
+#define MUTUA_TESTUTILS_STATICALGORITHMCOMPLEXITYANDREENTRANCYANALYSIS_H
+
+#include <string>
+#include <chrono>
+#include <iostream>
+#include <algorithm>
+
+#include "AlgorithmComplexityAndReentrancyAnalysis.h"
+
+using namespace std;
+
+namespace mutua::testutils {
+
+    /**
+     * StaticAlgorithmComplexityAndReentrancyAnalysis.h
+     * ================================================
+     * created Oct 17, 2026
+     *
+     * Header only, statically dispatched (CRTP) front-end for {@link AlgorithmComplexityAndReentrancyAnalysis}:
+     * 'Derived' provides non virtual 'insertOperation', 'selectOperation', 'updateOperation' and 'deleteOperation' methods,
+     * which are called from the range hooks with no virtual dispatch -- allowing the compiler to inline the algorithm under
+     * test into the timing loop, just like it would in production code. The passes, threading and complexity classification
+     * are the ones from the base class: only one virtual call per thread slice remains.
+     *
+     * Usage:
+     *
+     *   class MyAnalysis: public StaticAlgorithmComplexityAndReentrancyAnalysis<MyAnalysis> {
+     *   public:
+     *       MyAnalysis() : StaticAlgorithmComplexityAndReentrancyAnalysis("My Analysis", 1'000'000) {}
+     *       void resetTables(EResetOccasion occasion) override { ... }
+     *       inline void insertOperation(unsigned int i) { ... }
+     *       inline void selectOperation(unsigned int i) { ... }
+     *       ...
+     *   };
+     *
+     * or, with lambdas, see {@link #makeAlgorithmComplexityAndReentrancyAnalysis}.
+    */
+    template <typename Derived>
+    class StaticAlgorithmComplexityAndReentrancyAnalysis: public AlgorithmComplexityAndReentrancyAnalysis {
+
+    private:
+        Derived& derived() { return static_cast<Derived&>(*this); }
+
+    public:
+
+        using AlgorithmComplexityAndReentrancyAnalysis::AlgorithmComplexityAndReentrancyAnalysis;
+
+        // default operations -- to be hidden by 'Derived' -- refusing to analyse what was not provided
+        void insertOperation(unsigned int i) { AlgorithmComplexityAndReentrancyAnalysis::insertAlgorithm(i); }
+        void selectOperation(unsigned int i) { AlgorithmComplexityAndReentrancyAnalysis::selectAlgorithm(i); }
+        void updateOperation(unsigned int i) { AlgorithmComplexityAndReentrancyAnalysis::updateAlgorithm(i); }
+        void deleteOperation(unsigned int i) { AlgorithmComplexityAndReentrancyAnalysis::deleteAlgorithm(i); }
+
+        // per element hooks -- still virtually dispatched, for the reentrancy tests
+        void insertAlgorithm(unsigned int i) final { derived().insertOperation(i); }
+        void selectAlgorithm(unsigned int i) final { derived().selectOperation(i); }
+        void updateAlgorithm(unsigned int i) final { derived().updateOperation(i); }
+        void deleteAlgorithm(unsigned int i) final { derived().deleteOperation(i); }
+
+        // range hooks -- statically dispatched, for the complexity analysis
+        void insertRange(unsigned int begin, unsigned int end) final { for (unsigned int i=begin; i<end; i++) derived().insertOperation(i); }
+        void selectRange(unsigned int begin, unsigned int end) final { for (unsigned int i=begin; i<end; i++) derived().selectOperation(i); }
+        void updateRange(unsigned int begin, unsigned int end) final { for (unsigned int i=begin; i<end; i++) derived().updateOperation(i); }
+        void deleteRange(unsigned int begin, unsigned int end) final { for (unsigned int i=begin; i<end; i++) derived().deleteOperation(i); }
+
+        /** Quantifies the harness overhead by measuring, on a single thread, each operation over 'numberOfElements' elements both through
+          * the per element virtual hooks and through the statically dispatched range hooks. Elements are processed in alternating chunks,
+          * so both dispatch modes see the same data set sizes and cache conditions.
+          * Returns the report with the per operation costs, in nanoseconds, of each dispatch mode. */
+        string analyseDispatchOverhead(unsigned int numberOfElements, bool verbose) {
+
+            constexpr unsigned int chunkSize = 1024;
+
+            string outputMessages = "";
+            auto output = [&outputMessages, verbose](const string& s) {
+                outputMessages.append(s);
+                if (verbose) cerr << s << flush;
+            };
+
+            auto nowNS = []() -> unsigned long long {
+                return chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now().time_since_epoch()).count();
+            };
+
+            // measures 'virtualRange' and 'staticRange' on alternating chunks -- if 'sameElements', both are measured on every chunk.
+            // Returns the average nanoseconds per operation for {virtual, static} dispatches
+            auto measure = [&](auto virtualRange, auto staticRange, bool sameElements) -> pair<double, double> {
+                unsigned long long virtualNS = 0, staticNS = 0, virtualOps = 0, staticOps = 0;
+                for (unsigned int chunkBegin=0; chunkBegin<numberOfElements; chunkBegin+=chunkSize) {
+                    unsigned int chunkEnd     = std::min(chunkBegin+chunkSize, numberOfElements);
+                    bool         virtualFirst = (chunkBegin/chunkSize) % 2 == 0;
+                    for (int turn=0; turn<(sameElements ? 2 : 1); turn++) {
+                        bool               isVirtual = (turn == 0) == virtualFirst;
+                        unsigned long long start     = nowNS();
+                        if (isVirtual) virtualRange(chunkBegin, chunkEnd); else staticRange(chunkBegin, chunkEnd);
+                        unsigned long long elapsed   = nowNS() - start;
+                        (isVirtual ? virtualNS  : staticNS)  += elapsed;
+                        (isVirtual ? virtualOps : staticOps) += chunkEnd - chunkBegin;
+                    }
+                }
+                return {virtualOps == 0 ? 0.0 : ((double)virtualNS)/((double)virtualOps), staticOps == 0 ? 0.0 : ((double)staticNS)/((double)staticOps)};
+            };
+
+            auto reportLine = [](const string& operation, pair<double, double> costs) {
+                auto [virtualCost, staticCost] = costs;
+                return operation + ":\t" + to_string(virtualCost) + "\t" + to_string(staticCost) + "\t" + to_string(virtualCost - staticCost) +
+                       "\t(" + to_string(virtualCost > 0.0 ? 100.0*(virtualCost - staticCost)/virtualCost : 0.0) + "%)\n";
+            };
+
+            output(getTestName() + " Dispatch Overhead Analysis: ");
+            resetTables(EResetOccasion::FULL_RESET);
+
+            // the qualified base class range hooks call the per element virtual hooks
+            output("Insert ");
+            auto insertCosts = measure([this](unsigned int b, unsigned int e) { AlgorithmComplexityAndReentrancyAnalysis::insertRange(b, e); },
+                                       [this](unsigned int b, unsigned int e) { insertRange(b, e); }, false);
+            output("Select ");
+            auto selectCosts = measure([this](unsigned int b, unsigned int e) { AlgorithmComplexityAndReentrancyAnalysis::selectRange(b, e); },
+                                       [this](unsigned int b, unsigned int e) { selectRange(b, e); }, true);
+            output("Update ");
+            auto updateCosts = measure([this](unsigned int b, unsigned int e) { AlgorithmComplexityAndReentrancyAnalysis::updateRange(b, e); },
+                                       [this](unsigned int b, unsigned int e) { updateRange(b, e); }, true);
+            output("Delete ");
+            auto deleteCosts = measure([this](unsigned int b, unsigned int e) { AlgorithmComplexityAndReentrancyAnalysis::deleteRange(b, e); },
+                                       [this](unsigned int b, unsigned int e) { deleteRange(b, e); }, false);
+
+            resetTables(EResetOccasion::FINAL_RESET);
+            output("Done.\n"
+                   "        virtual (ns/op)\tstatic (ns/op)\toverhead (ns/op)\n" +
+                   reportLine("Insert", insertCosts) +
+                   reportLine("Select", selectCosts) +
+                   reportLine("Update", updateCosts) +
+                   reportLine("Delete", deleteCosts));
+
+            return outputMessages;
+        }
+    };
+
+
+    /** {@link StaticAlgorithmComplexityAndReentrancyAnalysis} taking the algorithms under test as callables (lambdas, functors, ...)
+      * -- see {@link #makeAlgorithmComplexityAndReentrancyAnalysis} */
+    template <typename Reset, typename Insert, typename Select, typename Update, typename Delete>
+    class CallableAlgorithmComplexityAndReentrancyAnalysis:
+            public StaticAlgorithmComplexityAndReentrancyAnalysis<CallableAlgorithmComplexityAndReentrancyAnalysis<Reset, Insert, Select, Update, Delete>> {
+
+    private:
+        Reset  reset;
+        Insert insert;
+        Select select;
+        Update update;
+        Delete remove;
+
+    public:
+
+        CallableAlgorithmComplexityAndReentrancyAnalysis(string testName, int elements, Reset reset, Insert insert, Select select, Update update, Delete remove)
+                : StaticAlgorithmComplexityAndReentrancyAnalysis<CallableAlgorithmComplexityAndReentrancyAnalysis>(testName, elements)
+                , reset (reset)
+                , insert(insert)
+                , select(select)
+                , update(update)
+                , remove(remove) {}
+
+        void resetTables(AlgorithmComplexityAndReentrancyAnalysis::EResetOccasion occasion) override { reset(occasion); }
+
+        inline void insertOperation(unsigned int i) { insert(i); }
+        inline void selectOperation(unsigned int i) { select(i); }
+        inline void updateOperation(unsigned int i) { update(i); }
+        inline void deleteOperation(unsigned int i) { remove(i); }
+    };
+
+    /** Builds a statically dispatched analysis for the given algorithms, as in:
+      *   auto analysis = makeAlgorithmComplexityAndReentrancyAnalysis("My Map", 1'000'000,
+      *                       [&](auto occasion)   { map.clear(); },
+      *                       [&](unsigned int i) { map[i] = i; },
+      *                       ...); */
+    template <typename Reset, typename Insert, typename Select, typename Update, typename Delete>
+    CallableAlgorithmComplexityAndReentrancyAnalysis<Reset, Insert, Select, Update, Delete>
+            makeAlgorithmComplexityAndReentrancyAnalysis(string testName, int elements, Reset reset, Insert insert, Select select, Update update, Delete remove) {
+        return CallableAlgorithmComplexityAndReentrancyAnalysis<Reset, Insert, Select, Update, Delete>(testName, elements, reset, insert, select, update, remove);
+    }
+}
+
+#endif //MUTUA_TESTUTILS_STATICALGORITHMCOMPLEXITYANDREENTRANCYANALYSIS_H
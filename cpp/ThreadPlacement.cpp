@@ -0,0 +1,238 @@
+#include <string>
+#include <fstream>
+#include <algorithm>
+#include <map>
+#include <set>
+#include <cstring>
+#include <sched.h>
+#include <errno.h>
+
+#include "ThreadPlacement.h"
+using namespace mutua::testutils;
+
+#include <BetterExceptions.h>
+#include <TimeMeasurements.h>
+using namespace mutua::cpputils;
+
+using namespace std;
+
+
+/** Parses the kernel's cpu list format -- "0-3,8,10-11" */
+static vector<int> parseCpuList(const string& list) {
+    vector<int> cpus;
+    size_t      position = 0;
+    while (position < list.size()) {
+        size_t comma = list.find(',', position);
+        string range = list.substr(position, comma == string::npos ? string::npos : comma-position);
+        size_t dash  = range.find('-');
+        if (!range.empty() && isdigit(range[0])) {
+            int first = stoi(range);
+            int last  = dash == string::npos ? first : stoi(range.substr(dash+1));
+            for (int cpu=first; cpu<=last; cpu++) {
+                cpus.push_back(cpu);
+            }
+        }
+        if (comma == string::npos) break;
+        position = comma+1;
+    }
+    return cpus;
+}
+
+/** Returns the first line of 'path' -- or "" if it cannot be read */
+static string readSysFile(const string& path) {
+    ifstream file(path);
+    string   line;
+    getline(file, line);
+    return line;
+}
+
+static int readSysInt(const string& path, int defaultValue) {
+    string value = readSysFile(path);
+    return (!value.empty() && isdigit(value[0])) ? stoi(value) : defaultValue;
+}
+
+
+string ThreadPlacement::EThreadPlacementToString(EThreadPlacement placement) {
+    switch (placement) {
+        case EThreadPlacement::FLOATING:
+            return "floating"s;
+        case EThreadPlacement::COMPACT:
+            return "compact"s;
+        case EThreadPlacement::SCATTER:
+            return "scatter"s;
+        case EThreadPlacement::CORE_LIST:
+            return "core list"s;
+        case EThreadPlacement::NUMA_NODE:
+            return "NUMA node"s;
+        default:
+            return "unpredicted thread placement -- update 'ThreadPlacement' source code to account for such case"s;
+    }
+}
+
+
+vector<ThreadPlacement::Cpu> ThreadPlacement::readTopology() {
+
+    // the NUMA node of each CPU -- all on node 0 if the kernel has no NUMA information
+    map<int, int> cpuNodes;
+    for (int node : parseCpuList(readSysFile("/sys/devices/system/node/online"))) {
+        for (int cpu : parseCpuList(readSysFile("/sys/devices/system/node/node" + to_string(node) + "/cpulist"))) {
+            cpuNodes[cpu] = node;
+        }
+    }
+
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0) {
+        THROW_EXCEPTION(std::runtime_error, "Could not read this process' CPU affinity: "s + strerror(errno));
+    }
+
+    vector<Cpu>             cpus;
+    map<pair<int,int>, int> smtSiblingsSoFar;      // {package, core} := number of hardware threads already seen
+    for (int cpu : parseCpuList(readSysFile("/sys/devices/system/cpu/online"))) {
+        if (!CPU_ISSET(cpu, &allowed)) {
+            continue;
+        }
+        string topology = "/sys/devices/system/cpu/cpu" + to_string(cpu) + "/topology/";
+        int    package  = readSysInt(topology + "physical_package_id", 0);
+        int    core     = readSysInt(topology + "core_id", cpu);
+        int    node     = cpuNodes.count(cpu) ? cpuNodes[cpu] : 0;
+        cpus.push_back({cpu, package, core, node, smtSiblingsSoFar[{package, core}]++});
+    }
+    return cpus;
+}
+
+
+ThreadPlacement::ThreadPlacement()
+        : ThreadPlacement(EThreadPlacement::FLOATING) {}
+
+
+ThreadPlacement::ThreadPlacement(EThreadPlacement placement)
+        : placement(placement) {
+
+    if (placement == EThreadPlacement::FLOATING) {
+        return;
+    }
+    if ( (placement != EThreadPlacement::COMPACT) && (placement != EThreadPlacement::SCATTER) ) {
+        THROW_EXCEPTION(std::invalid_argument, "'" + EThreadPlacementToString(placement) + "' thread placement requires its CPUs or NUMA node to be specified");
+    }
+
+    cpus = readTopology();
+    if (placement == EThreadPlacement::COMPACT) {
+        stable_sort(cpus.begin(), cpus.end(), [](const Cpu& a, const Cpu& b) {
+            return tie(a.package, a.core, a.smtSibling) < tie(b.package, b.core, b.smtSibling);
+        });
+    } else {
+        // the rank of each core inside its package, so the n-th core of every package comes before the (n+1)-th ones
+        map<int, set<int>> packageCores;
+        for (const Cpu& cpu : cpus) {
+            packageCores[cpu.package].insert(cpu.core);
+        }
+        auto coreRank = [&packageCores](const Cpu& cpu) {
+            return (int)distance(packageCores[cpu.package].begin(), packageCores[cpu.package].find(cpu.core));
+        };
+        stable_sort(cpus.begin(), cpus.end(), [&coreRank](const Cpu& a, const Cpu& b) {
+            return make_tuple(a.smtSibling, coreRank(a), a.package) < make_tuple(b.smtSibling, coreRank(b), b.package);
+        });
+    }
+}
+
+
+ThreadPlacement::ThreadPlacement(const vector<int>& coreList)
+        : placement(EThreadPlacement::CORE_LIST) {
+
+    vector<Cpu> topology = readTopology();
+    for (int requestedCpu : coreList) {
+        auto cpu = find_if(topology.begin(), topology.end(), [requestedCpu](const Cpu& cpu) { return cpu.cpu == requestedCpu; });
+        if (cpu == topology.end()) {
+            THROW_EXCEPTION(std::invalid_argument, "CPU #" + to_string(requestedCpu) + " is not online or this process is not allowed to run on it");
+        }
+        cpus.push_back(*cpu);
+    }
+    if (cpus.empty()) {
+        THROW_EXCEPTION(std::invalid_argument, "'core list' thread placement requires at least one CPU");
+    }
+}
+
+
+ThreadPlacement ThreadPlacement::onNumaNode(int numaNode) {
+    ThreadPlacement numaPlacement(EThreadPlacement::COMPACT);
+    numaPlacement.placement = EThreadPlacement::NUMA_NODE;
+    numaPlacement.cpus.erase(remove_if(numaPlacement.cpus.begin(), numaPlacement.cpus.end(), [numaNode](const Cpu& cpu) { return cpu.node != numaNode; }),
+                             numaPlacement.cpus.end());
+    if (numaPlacement.cpus.empty()) {
+        THROW_EXCEPTION(std::invalid_argument, "NUMA node #" + to_string(numaNode) + " has no CPUs this process is allowed to run on");
+    }
+    return numaPlacement;
+}
+
+
+void ThreadPlacement::pinCurrentThread(int threadIndex) const {
+    if (!isPinning()) {
+        return;
+    }
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    CPU_SET(cpus[threadIndex % cpus.size()].cpu, &cpuSet);
+    if (sched_setaffinity(0, sizeof(cpuSet), &cpuSet) != 0) {
+        THROW_EXCEPTION(std::runtime_error, "Could not pin analysis thread #" + to_string(threadIndex) + " to CPU #" + to_string(cpus[threadIndex % cpus.size()].cpu) + ": " + strerror(errno));
+    }
+}
+
+
+vector<int> ThreadPlacement::restrictCurrentThreadToPlacementCpus() const {
+    cpu_set_t previous;
+    CPU_ZERO(&previous);
+    sched_getaffinity(0, sizeof(previous), &previous);
+    vector<int> previousCpus;
+    for (int cpu=0; cpu<CPU_SETSIZE; cpu++) {
+        if (CPU_ISSET(cpu, &previous)) previousCpus.push_back(cpu);
+    }
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    for (const Cpu& cpu : cpus) {
+        CPU_SET(cpu.cpu, &cpuSet);
+    }
+    sched_setaffinity(0, sizeof(cpuSet), &cpuSet);
+    return previousCpus;
+}
+
+
+void ThreadPlacement::restoreCurrentThreadAffinity(const vector<int>& cpus) {
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    for (int cpu : cpus) {
+        CPU_SET(cpu, &cpuSet);
+    }
+    sched_setaffinity(0, sizeof(cpuSet), &cpuSet);
+}
+
+
+string ThreadPlacement::toString() const {
+    if (!isPinning()) {
+        return EThreadPlacementToString(placement) + " (threads are not pinned)";
+    }
+    string                     cpuList, smtSiblings;
+    set<int>                   packages, nodes;
+    map<pair<int,int>, string> coreSiblings;
+    for (const Cpu& cpu : cpus) {
+        cpuList += (cpuList.empty() ? "" : ",") + to_string(cpu.cpu);
+        packages.insert(cpu.package);
+        nodes.insert(cpu.node);
+        string& siblings = coreSiblings[{cpu.package, cpu.core}];
+        siblings += (siblings.empty() ? "" : "+") + to_string(cpu.cpu);
+    }
+    for (auto& [core, siblings] : coreSiblings) {
+        if (siblings.find('+') != string::npos) {
+            smtSiblings += (smtSiblings.empty() ? "" : " ") + siblings;
+        }
+    }
+    auto join = [](const set<int>& values) {
+        string joined;
+        for (int value : values) joined += (joined.empty() ? "" : ",") + to_string(value);
+        return joined;
+    };
+    return EThreadPlacementToString(placement) + " on CPUs " + cpuList +
+           " -- packages: " + join(packages) +
+           "; NUMA nodes: " + join(nodes) +
+           "; SMT siblings: " + (smtSiblings.empty() ? "none" : smtSiblings);
+}
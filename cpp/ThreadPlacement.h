@@ -0,0 +1,99 @@
+//#pragma once
+#ifndef MUTUA_TESTUTILS_THREADPLACEMENT_H
+#define MUTUA_TESTUTILS_THREADPLACEMENT_H
+
+#include <string>
+#include <vector>
+
+using namespace std;
+
+namespace mutua::testutils {
+
+    /**
+     * ThreadPlacement.h
+     * =================
+     * created Oct 17, 2026
+     *
+     * Decides on which CPU each analysis thread runs, so passes are not disturbed by threads migrating between cores or sockets.
+     * The topology -- packages, cores, SMT siblings & NUMA nodes -- is read from '/sys/devices/system', restricted to the CPUs
+     * this process is allowed to run on:
+     *   - FLOATING:  threads are not pinned -- the operating system decides;
+     *   - COMPACT:   threads fill all SMT siblings of a core, then all cores of a package, then the next package;
+     *   - SCATTER:   threads are spread across packages first, then cores, using SMT siblings last;
+     *   - CORE_LIST: threads are pinned, round robin, to the given CPUs;
+     *   - NUMA_NODE: threads are pinned, compactly, to the CPUs of the given NUMA node.
+    */
+    class ThreadPlacement {
+
+    public:
+
+        enum class EThreadPlacement {
+            FLOATING, COMPACT, SCATTER, CORE_LIST, NUMA_NODE
+        };
+
+        /** Returns an human explanation of {@link #EThreadPlacement} */
+        static string EThreadPlacementToString(EThreadPlacement placement);
+
+        struct Cpu {
+            int cpu;
+            int package;
+            int core;
+            int node;
+            int smtSibling;     // 0 for the first hardware thread of the core, 1 for the second, ...
+        };
+
+    private:
+        EThreadPlacement placement;
+        vector<Cpu>      cpus;          // the CPUs threads are placed on, in placement order -- empty if FLOATING
+
+    public:
+
+        /** FLOATING placement */
+        ThreadPlacement();
+
+        /** COMPACT, SCATTER or FLOATING placement on all allowed CPUs */
+        explicit ThreadPlacement(EThreadPlacement placement);
+
+        /** CORE_LIST placement */
+        explicit ThreadPlacement(const vector<int>& coreList);
+
+        /** NUMA_NODE placement */
+        static ThreadPlacement onNumaNode(int numaNode);
+
+        /** Returns the topology of all CPUs this process may run on */
+        static vector<Cpu> readTopology();
+
+        EThreadPlacement getPlacement() const { return placement; }
+        bool             isPinning()    const { return placement != EThreadPlacement::FLOATING; }
+
+        /** Pins the calling thread to the CPU of the 'threadIndex'th analysis thread -- does nothing if FLOATING */
+        void pinCurrentThread(int threadIndex) const;
+
+        /** Runs 'task' on the calling thread, temporarily restricted to all placement CPUs, so the memory it allocates is first
+          * touched on the NUMA node(s) the analysis threads will run on */
+        template <typename Task>
+        void runOnPlacementCpus(Task task) const {
+            if (!isPinning()) {
+                task();
+                return;
+            }
+            auto previousAffinity = restrictCurrentThreadToPlacementCpus();
+            try {
+                task();
+            } catch (...) {
+                restoreCurrentThreadAffinity(previousAffinity);
+                throw;
+            }
+            restoreCurrentThreadAffinity(previousAffinity);
+        }
+
+        /** Returns the placement policy and the topology of the chosen CPUs: "compact on CPUs 0,1,2,3 -- packages: 0; NUMA nodes: 0; SMT siblings: 0+2 1+3" */
+        string toString() const;
+
+    private:
+        vector<int> restrictCurrentThreadToPlacementCpus() const;
+        static void restoreCurrentThreadAffinity(const vector<int>& cpus);
+    };
+}
+
+#endif //MUTUA_TESTUTILS_THREADPLACEMENT_H
@@ -14,6 +14,8 @@ using namespace std;
 using namespace mutua::cpputils;
 
 #include "../../cpp/AlgorithmComplexityAndReentrancyAnalysis.h"
+#include "../../cpp/StaticAlgorithmComplexityAndReentrancyAnalysis.h"
+#include "../../cpp/PerformanceBaseline.h"
 #include <SplitRun.h>
 using namespace mutua::testutils;
 
@@ -99,8 +101,12 @@ void databaseAlgorithmAnalysisLowLevelExperiments() {
     cout << "\t::BetterThanO1:      " << AlgorithmComplexityAndReentrancyAnalysis::EAlgorithmComplexityToString(AlgorithmComplexityAndReentrancyAnalysis::EAlgorithmComplexity::BetterThanO1)      << endl;
     cout << "\t::O1:                " << AlgorithmComplexityAndReentrancyAnalysis::EAlgorithmComplexityToString(AlgorithmComplexityAndReentrancyAnalysis::EAlgorithmComplexity::O1)                << endl;
     cout << "\t::Ologn:             " << AlgorithmComplexityAndReentrancyAnalysis::EAlgorithmComplexityToString(AlgorithmComplexityAndReentrancyAnalysis::EAlgorithmComplexity::Ologn)             << endl;
+    cout << "\t::Olog2n:            " << AlgorithmComplexityAndReentrancyAnalysis::EAlgorithmComplexityToString(AlgorithmComplexityAndReentrancyAnalysis::EAlgorithmComplexity::Olog2n)            << endl;
+    cout << "\t::Osqrtn:            " << AlgorithmComplexityAndReentrancyAnalysis::EAlgorithmComplexityToString(AlgorithmComplexityAndReentrancyAnalysis::EAlgorithmComplexity::Osqrtn)            << endl;
     cout << "\t::BetweenOLogNAndOn: " << AlgorithmComplexityAndReentrancyAnalysis::EAlgorithmComplexityToString(AlgorithmComplexityAndReentrancyAnalysis::EAlgorithmComplexity::BetweenOLogNAndOn) << endl;
     cout << "\t::On:                " << AlgorithmComplexityAndReentrancyAnalysis::EAlgorithmComplexityToString(AlgorithmComplexityAndReentrancyAnalysis::EAlgorithmComplexity::On)                << endl;
+    cout << "\t::Onlogn:            " << AlgorithmComplexityAndReentrancyAnalysis::EAlgorithmComplexityToString(AlgorithmComplexityAndReentrancyAnalysis::EAlgorithmComplexity::Onlogn)            << endl;
+    cout << "\t::On2:               " << AlgorithmComplexityAndReentrancyAnalysis::EAlgorithmComplexityToString(AlgorithmComplexityAndReentrancyAnalysis::EAlgorithmComplexity::On2)               << endl;
     cout << "\t::WorseThanOn:       " << AlgorithmComplexityAndReentrancyAnalysis::EAlgorithmComplexityToString(AlgorithmComplexityAndReentrancyAnalysis::EAlgorithmComplexity::WorseThanOn)       << endl;
 
     // insertion test:
@@ -134,6 +140,46 @@ void databaseAlgorithmAnalysisLowLevelExperiments() {
         }
     }
 
+    // sweep (regression) test: 7 sizes, with noise-free O(log(n)) selects, but with a hiccup on the 4th pass
+    vector<unsigned long long> sweepDeltaTs;
+    vector<unsigned int>       sweepNs, sweepRs;
+    for (unsigned int k=0; k<7; k++) {
+        sweepNs.push_back(1000<<k);
+        sweepRs.push_back(1000);
+        sweepDeltaTs.push_back((unsigned long long)(10.0*1000*log2(1000<<k)) * (k == 3 ? 2 : 1));
+    }
+    cout << "If Selecting/Updating in O(log(n)) on a 7 sizes sweep, with a hiccup on the 4th pass, I'd get: " << endl;
+    double goodnessOfFit;
+    tie(complexity, goodnessOfFit, ignore, algorithmAnalysisReport) = AlgorithmComplexityAndReentrancyAnalysis::computeAlgorithmAnalysisByRegression("Update/Select Sweep Test"s, sweepDeltaTs, sweepNs, sweepNs, sweepRs);
+    cout << algorithmAnalysisReport << flush;
+
+    // Mann-Whitney U test: p-values on small samples with known answers -- candidate times tending to be greater are the regressions
+    cout << "Mann-Whitney U one sided p-values (candidate greater than baseline):" << endl;
+    cout << "\tm=n=3, fully separated (exact: 1/20 = 0.05):  " << PerformanceBaseline::mannWhitneyUGreaterPValue({4, 5, 6}, {1, 2, 3}) << endl;
+    cout << "\tm=n=3, interleaved, U=6 (exact: 7/20 = 0.35): " << PerformanceBaseline::mannWhitneyUGreaterPValue({2, 4, 6}, {1, 3, 5}) << endl;
+    cout << "\tm=n=3, candidate smaller (exact: 1.0):        " << PerformanceBaseline::mannWhitneyUGreaterPValue({1, 2, 3}, {4, 5, 6}) << endl;
+    cout << "\tm=n=5, same samples, U=12.5 (normal: ~0.54):  " << PerformanceBaseline::mannWhitneyUGreaterPValue({1, 2, 3, 4, 5}, {1, 2, 3, 4, 5}) << endl;
+    cout << "\tm=n=4, shifted, ties, U=14 (normal: ~0.054):  " << PerformanceBaseline::mannWhitneyUGreaterPValue({3, 4, 5, 6}, {1, 2, 3, 4}) << endl;
+    cout << "\tm=n=3, all values equal (no evidence: 1.0):   " << PerformanceBaseline::mannWhitneyUGreaterPValue({7, 7, 7}, {7, 7, 7}) << endl;
+
+    // linearizability checker test: hand built histories -- one thread of the run at a time, so the real time order is the recording order
+    auto recordOperation = [](OperationHistory& history, int thread, OperationHistory::EOperation operation, unsigned int key, long long value) {
+        history.record(thread, operation, key, [value] { OperationHistory::observe(value); });
+    };
+    OperationHistory staleReadHistory(2, 16, PrecisionClock());
+    recordOperation(staleReadHistory, 0, OperationHistory::EOperation::INSERT, 7, 10);
+    recordOperation(staleReadHistory, 1, OperationHistory::EOperation::UPDATE, 7, 20);
+    recordOperation(staleReadHistory, 0, OperationHistory::EOperation::SELECT, 7, 10);     // stale: the update already responded
+    cout << "If a select read an old value after an update responded, I'd get: " << endl;
+    cout << get<1>(staleReadHistory.check([](unsigned int) { return false; })) << flush;
+    OperationHistory resurrectedKeyHistory(2, 16, PrecisionClock());
+    recordOperation(resurrectedKeyHistory, 0, OperationHistory::EOperation::INSERT, 3, 30);
+    recordOperation(resurrectedKeyHistory, 1, OperationHistory::EOperation::DELETE, 3, 30);
+    recordOperation(resurrectedKeyHistory, 0, OperationHistory::EOperation::SELECT, 3, 30);     // resurrected: the delete already responded
+    recordOperation(resurrectedKeyHistory, 1, OperationHistory::EOperation::SELECT, 4, OperationHistory::unknownValue);     // initially present, value unknown
+    cout << "If a deleted key could still be selected, I'd get: " << endl;
+    cout << get<1>(resurrectedKeyHistory.check([](unsigned int key) { return key == 4; })) << flush;
+
 #define TEST_INSERT(testName, insertFunction)                                                                                                              \
     n = 1000;                                                                                                                                              \
     cout << "Real " << testName << " with " << n << " elements on each pass" << flush;                                                                     \
@@ -195,8 +241,8 @@ void databaseAlgorithmAnalysisHighLevelExperiments() {
     class HelloDatabaseAlgorithmAnalysisWorld: public AlgorithmComplexityAndReentrancyAnalysis {
     public:
         std::vector<int> elements;
-        std::mutex  writeGuard;
-        std::mutex* readGuard;
+        InstrumentedMutex  writeGuard{"writeGuard"};   // reports its contention on each operation
+        InstrumentedMutex* readGuard;
 
         HelloDatabaseAlgorithmAnalysisWorld()
                 : AlgorithmComplexityAndReentrancyAnalysis("Hello, Database Algorithm Analysis World!!", 2000, 2000, 2000)
@@ -209,31 +255,35 @@ void databaseAlgorithmAnalysisHighLevelExperiments() {
         }
 
         void insertAlgorithm(unsigned int i) override {
-            std::lock_guard<std::mutex> lock(writeGuard);
+            std::lock_guard<InstrumentedMutex> lock(writeGuard);
         	readGuard = &writeGuard;
             elements[i] = i;
+            OperationHistory::observe(i);
             readGuard = nullptr;
         }
 
         void selectAlgorithm(unsigned int i) override {
-        	if (readGuard != nullptr) std::lock_guard<std::mutex> lock(*readGuard);
+        	if (readGuard != nullptr) std::lock_guard<InstrumentedMutex> lock(*readGuard);
+            OperationHistory::observe(elements[i]);
             if (elements[i] != ((int)i)) {
                 cerr << "Select: item #" << i << ", on the insert phase, should be " << ((int)i) << " but is " << elements[i] << endl << flush;
             }
         }
 
         void updateAlgorithm(unsigned int i) override {
-            std::lock_guard<std::mutex> lock(writeGuard);
+            std::lock_guard<InstrumentedMutex> lock(writeGuard);
         	readGuard = &writeGuard;
             elements[i] = -((int)i);
+            OperationHistory::observe(-((int)i));
             readGuard = nullptr;
         }
 
         void deleteAlgorithm(unsigned int i) override {
-            std::lock_guard<std::mutex> lock(writeGuard);
+            std::lock_guard<InstrumentedMutex> lock(writeGuard);
         	readGuard = &writeGuard;
         	int value = elements[i];
             elements[i] -1;
+            OperationHistory::observe(value);
             if (value != -((int)i)) {
                 cerr << "Delete: item #" << i << ", on the update phase, should be " << -((int)i) << " but was " << value << endl << flush;
             }
@@ -241,7 +291,9 @@ void databaseAlgorithmAnalysisHighLevelExperiments() {
         }
     };
     HelloDatabaseAlgorithmAnalysisWorld().analyseComplexity(true, 4, 4, 4, 4, true);
-    HelloDatabaseAlgorithmAnalysisWorld().testReentrancy(2000, true);
+    HelloDatabaseAlgorithmAnalysisWorld helloDatabaseAlgorithmAnalysisWorld;
+    helloDatabaseAlgorithmAnalysisWorld.enableHistoryRecording(2000);     // checks the reentrancy test is linearizable, using the observed values
+    helloDatabaseAlgorithmAnalysisWorld.testReentrancy(2000, true);
 
     class ReentrancyExperiments: public AlgorithmComplexityAndReentrancyAnalysis {
     public:
@@ -271,6 +323,13 @@ void databaseAlgorithmAnalysisHighLevelExperiments() {
             selectElements[i]++;
         }
 
+        // batched version, sparing one virtual call per element during the complexity analysis
+        void selectRange(unsigned int begin, unsigned int end) override {
+            for (unsigned int i=begin; i<end; i++) {
+                selectElements[i]++;
+            }
+        }
+
         void updateAlgorithm(unsigned int i) override {
             updateElements[i]++;
         }
@@ -295,12 +354,23 @@ void databaseAlgorithmAnalysisHighLevelExperiments() {
             return sum;
         }
 
+        // elements operated on, but never inserted
+        int countPhantoms(std::vector<int> operation) {
+            int phantomCount = 0;
+            for (size_t i=0; i<operation.size(); i++) {
+                phantomCount += ( (operation[i] != 0) && (insertElements[i] == 0) ? 1 : 0 );
+            }
+            return phantomCount;
+        }
+
         void report() {
             int gaps, sum;
             cout << "Insert: " << countGaps(insertElements) << " gaps, summing " << sumElements(insertElements) << ";" << endl;
             cout << "Select: " << countGaps(selectElements) << " gaps, summing " << sumElements(selectElements) << ";" << endl;
             cout << "Update: " << countGaps(updateElements) << " gaps, summing " << sumElements(updateElements) << ";" << endl;
             cout << "Delete: " << countGaps(deleteElements) << " gaps, summing " << sumElements(deleteElements) << ";" << endl;
+            cout << "Phantoms (never inserted): " << countPhantoms(selectElements) << " selected, " << countPhantoms(updateElements) << " updated, " <<
+                    countPhantoms(deleteElements) << " deleted;" << endl;
         }
     };
     ReentrancyExperiments reentrancyExperiments = ReentrancyExperiments();
@@ -308,16 +378,83 @@ void databaseAlgorithmAnalysisHighLevelExperiments() {
     reentrancyExperiments.report();
     reentrancyExperiments.testReentrancy(_numberOfElements, true);
     reentrancyExperiments.report();
-
-    cout << "Memory Leak Tests (go check on top if the ram usage is constant over time): " << flush;
-    for (int i=0; i<5; i++) {
-        if (i%76 == 0) {
-            cout << endl;
-        }
-        reentrancyExperiments.analyseComplexity(false, _threads, _threads, _threads, _threads, false);
-        cout << '.' << flush;
+    reentrancyExperiments.testReentrancy(_numberOfElements, _threads, _threads*2, _threads/2, _threads/2, true);
+    reentrancyExperiments.report();
+    try {
+        reentrancyExperiments.setClock(PrecisionClock(PrecisionClock::EClockSource::TSC));
+    } catch (const std::exception& e) {
+        cout << "Keeping the default clock: " << e.what() << endl;
     }
-    cout << endl << endl << flush;
+    reentrancyExperiments.enableLatencyHistograms(true);
+    reentrancyExperiments.setThreadPlacement(ThreadPlacement(ThreadPlacement::EThreadPlacement::COMPACT));
+    reentrancyExperiments.analyseComplexitySweep(false, 5, _threads, _threads, _threads, _threads, true);
+    reentrancyExperiments.getLastComplexityAnalysisResult().writeJSON(cout);
+    reentrancyExperiments.setThreadPlacement(ThreadPlacement());
+    // thread counts not dividing the sweep sizes -- the remainders are inserted untimed, so no phantoms should be reported
+    reentrancyExperiments.analyseComplexitySweep(false, 5, 7, 7, 7, 7, true);
+    reentrancyExperiments.report();
+    reentrancyExperiments.enableLatencyHistograms(false);
+    reentrancyExperiments.enablePerformanceCounters(true);
+    reentrancyExperiments.enableAllocationTracking(true);
+    reentrancyExperiments.enableOperationTimelines(true);
+    reentrancyExperiments.analyseComplexity(false, _threads, _threads, _threads, _threads, true);
+    reentrancyExperiments.enableOperationTimelines(false);
+    reentrancyExperiments.enableAllocationTracking(false);
+    reentrancyExperiments.enablePerformanceCounters(false);
+
+    // the same experiments, with the operations inlined into the timing loops
+    std::vector<int> staticElements;
+    auto staticDispatchExperiments = makeAlgorithmComplexityAndReentrancyAnalysis("StaticDispatchExperiments", _numberOfElements,
+        [&](auto)            { staticElements = std::vector<int>(_numberOfElements, 0); },
+        [&](unsigned int i) { staticElements[i]++; },
+        [&](unsigned int i) { staticElements[i]++; },
+        [&](unsigned int i) { staticElements[i]++; },
+        [&](unsigned int i) { staticElements[i]++; });
+    staticDispatchExperiments.analyseComplexity(false, _threads, _threads, _threads, _threads, true);
+    staticDispatchExperiments.analyseDispatchOverhead(_numberOfElements, true);
+    staticDispatchExperiments.analyseComplexityTrials(false, _threads, _threads, _threads, _threads, 0.10, 30.0, 3, true);
+
+    // regression gate against the previous runs' baseline
+    PerformanceBaseline baseline(staticDispatchExperiments.getTestName());
+    vector<AlgorithmComplexityAndReentrancyAnalysis::ComplexityAnalysisResult> trials;
+    for (int trial=0; trial<5; trial++) {
+        staticDispatchExperiments.analyseComplexity(false, _threads, _threads, _threads, _threads, false);
+        trials.push_back(staticDispatchExperiments.getLastComplexityAnalysisResult());
+    }
+    auto [regressed, baselineReport] = baseline.compare(trials);
+    cout << baselineReport << flush;
+    if (!regressed) {
+        baseline.record(trials);
+        baseline.save();
+    }
+
+    // the same, with the number of elements chosen for ~200ms passes -- bound by the tables' size
+    staticDispatchExperiments.autoSizeElements(0.2, 2.0, _numberOfElements, true);
+    staticDispatchExperiments.analyseComplexity(false, _threads, _threads, _threads, _threads, true);
+
+    // the same, on skewed & random accesses
+    staticDispatchExperiments.setKeyDistribution(KeyDistribution::zipfian(0.99));
+    staticDispatchExperiments.analyseComplexity(false, _threads, _threads, _threads, _threads, true);
+    staticDispatchExperiments.setKeyDistribution(KeyDistribution(KeyDistribution::EKeyDistribution::UNIFORM_RANDOM));
+    staticDispatchExperiments.analyseComplexity(false, _threads, _threads, _threads, _threads, true);
+    staticDispatchExperiments.setKeyDistribution(KeyDistribution());
+
+    // concurrent YCSB like operation mixes, on growing data sets -- leaving half of the elements for the workload inserts
+    reentrancyExperiments.analyseMixedWorkload(AlgorithmComplexityAndReentrancyAnalysis::MixedWorkload::ycsb('B'), {_numberOfElements/8, _numberOfElements/4, _numberOfElements/2}, _threads, 1.0, true);
+    reentrancyExperiments.analyseMixedWorkload(AlgorithmComplexityAndReentrancyAnalysis::MixedWorkload::ycsb('D'), {_numberOfElements/8, _numberOfElements/4, _numberOfElements/2}, _threads, 1.0, true);
+    // the latency versus throughput curve, on a fixed schedule -- latencies counted from each operation's intended start
+    reentrancyExperiments.analyseOpenLoop(AlgorithmComplexityAndReentrancyAnalysis::MixedWorkload::ycsb('C'), _numberOfElements/2, _threads, {1'000, 10'000, 100'000, 1'000'000}, 1.0, true);
+
+    // where each operation stops scaling -- 1, 2, 4, ... threads, up to the hardware concurrency
+    staticDispatchExperiments.analyseScalability(false, 0, true);
+
+    // selects & updates across the L1d, L2, L3 & DRAM boundaries -- algorithmic growth versus memory hierarchy effects
+    staticDispatchExperiments.analyseCacheHierarchySweep(CacheHierarchy::read(), 3, 0.0, true);
+
+    cout << "Memory Leak Tests:" << endl << flush;
+    auto [soakOutput, soakSamples, leakBytesPerCycle, residentSetSizeBytesPerCycle, throughputDriftPercentPerHour] =
+        reentrancyExperiments.analyseSoak(60.0, _threads, 4096, true);
+    cout << endl << flush;
 
 #undef _numberOfElements
 #undef _threads